@@ -0,0 +1,205 @@
+#ifndef STRUCTURES_POOL_ALLOCATOR_H
+#define STRUCTURES_POOL_ALLOCATOR_H
+
+#include <cstdint>  // std::size_t
+#include <memory>  // std::allocator, std::shared_ptr
+#include <type_traits>  // std::aligned_storage, std::is_trivially_destructible
+
+namespace structures {
+
+//! Classe PoolAllocator
+/*! A classe PoolAllocator é um alocador de nodos: reserva blocos contíguos
+ *  de ChunkSize posições e reaproveita as posições liberadas por uma lista
+ *  livre, então alocar e liberar um nodo custa O(1) sem chamar o heap.
+ *  Cada estrutura que o usa recebe a sua própria arena, que pode ser
+ *  liberada inteira de uma vez com release(). */
+
+template<typename T, std::size_t ChunkSize = 256>
+class PoolAllocator {
+    static_assert(ChunkSize > 0, "O bloco precisa ter ao menos uma posição.");
+
+ public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    template<typename U>
+    struct rebind {
+        using other = PoolAllocator<U, ChunkSize>;
+    };
+
+    PoolAllocator() = default;
+
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U, ChunkSize>&) {}
+    // outro tipo de dado (rebind): nova arena, o tamanho das posições muda
+
+    //! Método select_on_container_copy_construction
+    /*! Uma estrutura copiada recebe uma arena nova, e não a do original. */
+    PoolAllocator select_on_container_copy_construction() const {
+        return PoolAllocator();
+    }
+
+    //! Método allocate
+    /*! O método allocate retorna memória para n dados; um dado por vez vem
+     *  da arena, pedidos maiores vão direto para o heap. */
+    T* allocate(std::size_t n) {
+        if (n != 1) {
+            return std::allocator<T>().allocate(n);
+        }
+        if (!pool_) {
+            pool_ = std::make_shared<Pool>();
+        }
+        return pool_->allocate();
+    }
+
+    //! Método deallocate
+    /*! O método deallocate devolve a posição para a lista livre da arena. */
+    void deallocate(T* p, std::size_t n) {
+        if (n != 1) {
+            std::allocator<T>().deallocate(p, n);
+        } else {
+            pool_->deallocate(p);
+        }
+    }
+
+    //! Método reserve
+    /*! O método reserve garante que os próximos n pedidos de um dado saiam de
+     *  posições contíguas de um mesmo bloco, se não houver posições livres
+     *  a reaproveitar. */
+    void reserve(std::size_t n) {
+        if (!pool_) {
+            pool_ = std::make_shared<Pool>();
+        }
+        pool_->reserve(n);
+    }
+
+    //! Método unique
+    /*! O método unique verifica se só este alocador usa a sua arena. */
+    bool unique() const {
+        return pool_.use_count() <= 1;
+    }
+
+    //! Método release
+    /*! O método release libera todos os blocos da arena de uma vez, sem
+     *  percorrer as posições. Nenhum destrutor é chamado. */
+    void release() {
+        if (pool_) {
+            pool_->release();
+        }
+    }
+
+    bool operator==(const PoolAllocator& other) const {
+        return pool_ == other.pool_;
+    }
+
+    bool operator!=(const PoolAllocator& other) const {
+        return pool_ != other.pool_;
+    }
+
+ private:
+    union Slot {
+        Slot* next;  // lista livre, ou bloco anterior na posição 0
+        std::size_t count;  // posições do bloco, na posição 1
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+    class Pool {
+     public:
+        Pool() = default;
+        Pool(const Pool&) = delete;
+        Pool& operator=(const Pool&) = delete;
+
+        ~Pool() {
+            release();
+        }
+
+        T* allocate() {
+            Slot *slot = free_;
+            if (slot != nullptr) {
+                free_ = slot->next;
+            } else {
+                if (bump_ == end_) {
+                    grow(ChunkSize);
+                }
+                slot = bump_++;
+            }
+            return reinterpret_cast<T*>(slot);
+        }
+
+        void deallocate(T* p) {
+            Slot *slot = reinterpret_cast<Slot*>(p);
+            slot->next = free_;
+            free_ = slot;
+        }
+
+        void reserve(std::size_t n) {
+            if (static_cast<std::size_t>(end_-bump_) < n) {
+                grow(n > ChunkSize ? n : ChunkSize);
+            }
+        }  // o resto do bloco atual fica sem uso até o release
+
+        void release() {
+            while (chunks_ != nullptr) {
+                Slot *previous = chunks_->next;
+                std::allocator<Slot>().deallocate(chunks_, chunks_[1].count+2);
+                chunks_ = previous;
+            }
+            free_ = nullptr;
+            bump_ = nullptr;
+            end_ = nullptr;
+        }
+
+     private:
+        void grow(std::size_t count) {
+            Slot *chunk = std::allocator<Slot>().allocate(count+2);
+            chunk[0].next = chunks_;
+            chunk[1].count = count;
+            chunks_ = chunk;
+            bump_ = chunk+2;
+            end_ = chunk+2+count;
+        }  // novo bloco; as posições 0 e 1 encadeiam e medem os blocos
+
+        Slot* chunks_{nullptr};
+        Slot* free_{nullptr};
+        Slot* bump_{nullptr};  // próxima posição nunca usada do bloco atual
+        Slot* end_{nullptr};
+    };
+
+    std::shared_ptr<Pool> pool_;  // criada no primeiro allocate
+};
+
+//! Função release_arena
+/*! A função release_arena libera de uma vez todos os nodos de uma estrutura
+ *  quando a arena é só dela e os nodos não precisam de destrutor.
+ *  Retorna false se os nodos precisam ser liberados um a um. */
+
+template<typename Alloc>
+bool release_arena(Alloc&) {
+    return false;
+}
+
+template<typename T, std::size_t ChunkSize>
+bool release_arena(PoolAllocator<T, ChunkSize>& alloc) {
+    if (!std::is_trivially_destructible<T>::value || !alloc.unique()) {
+        return false;
+    }  // uma arena compartilhada ainda guarda nodos de outra estrutura
+    alloc.release();
+    return true;
+}
+
+//! Função reserve_arena
+/*! A função reserve_arena prepara um bloco contíguo para n nodos quando o
+ *  alocador é uma arena; nos demais alocadores não faz nada. */
+
+template<typename Alloc>
+void reserve_arena(Alloc&, std::size_t) {}
+
+template<typename T, std::size_t ChunkSize>
+void reserve_arena(PoolAllocator<T, ChunkSize>& alloc, std::size_t n) {
+    alloc.reserve(n);
+}
+
+}  // namespace structures
+
+#endif
@@ -3,48 +3,190 @@
 #ifndef STRUCTURES_AVL_TREE_H
 #define STRUCTURES_AVL_TREE_H
 
+#include <cstddef>  // std::ptrdiff_t
+#include <cstdint>  // std::uint64_t
+#include <future>  // std::async, std::future
+#include <iterator>  // std::bidirectional_iterator_tag, std::distance
+#include <memory>  // std::allocator, std::allocator_traits
+#include <stdexcept>  // C++ exceptions
+#include <system_error>  // std::system_error
+#include <thread>  // std::thread::hardware_concurrency
+#include <type_traits>  // std::is_same
+#include <utility>  // std::move, std::forward, std::swap, std::pair
+
+#include "./Alocador.hpp"
+#include "./ArvoreCongelada.hpp"
 #include "array_list.h"
 
 namespace structures {
 
+//! Estrutura SubtreeCount
+/*! A estrutura SubtreeCount guarda quantos nodos há na subárvore de um nodo
+ *  da AVLTree. Sem a contagem (Counted = false) ela é vazia e não ocupa
+ *  memória no nodo. */
+
+template<bool Counted>
+struct SubtreeCount {
+    std::size_t count() const {
+        return count_;
+    }
+
+    void count(std::size_t n) {
+        count_ = n;
+    }
+
+    std::size_t count_{1u};
+};
+
+template<>
+struct SubtreeCount<false> {
+    std::size_t count() const {
+        return 0u;
+    }
+
+    void count(std::size_t) {}
+};
+
 //! Classe AVLTree
-/*! A classe AVLTree é uma árvore binéria com condição de balanço. */
+/*! A classe AVLTree é uma árvore binéria com condição de balanço. Com
+ *  Counted = true cada nodo guarda o tamanho da sua subárvore, o que dá
+ *  select, rank e count_range em O(log n). */
 
-template<typename T>
+template<typename T, typename Alloc = std::allocator<T>, bool Counted = false>
 class AVLTree {
+    struct Node;
+    class Iterator;
+    class Range;
+
  public:
+    using const_iterator = Iterator;
+    using iterator = const_iterator;  // os dados não podem ser alterados
+
     AVLTree() = default;
 
+    explicit AVLTree(const Alloc& alloc):
+        alloc_{alloc}
+    {}  // nodos alocados por alloc
+
+    AVLTree(const AVLTree& other):
+        size_{other.size_},
+        alloc_{NodeTraits::select_on_container_copy_construction(other.alloc_)}
+    {
+        root = clone(other.root, alloc_);
+    }  // cópia profunda, com a mesma forma
+
+    AVLTree(AVLTree&& other) noexcept:
+        root{other.root},
+        size_{other.size_},
+        alloc_{std::move(other.alloc_)}
+    {
+        other.root = nullptr;
+        other.size_ = 0;
+    }  // toma os nodos de other
+
+    AVLTree& operator=(AVLTree other) {
+        swap(other);
+        return *this;
+    }  // cópia ou movimento conforme o argumento
+
     ~AVLTree() {
-        delete root;
+        if (root != nullptr && !release_arena(alloc_)) {
+            dispose_all(alloc_, root);
+        }
         size_ = 0u;
     }
 
+    //! Método from_sorted
+    /*! O método from_sorted constrói uma árvore perfeitamente balanceada a
+     *  partir de um intervalo já ordenado, em O(n) e sem rotações. Com um
+     *  PoolAllocator, todos os nodos ficam num só bloco contíguo. */
+    template<typename ForwardIt>
+    static AVLTree from_sorted(ForwardIt first, ForwardIt last,
+                               const Alloc& alloc = Alloc()) {
+        AVLTree tree(alloc);
+        std::size_t n = std::distance(first, last);
+        reserve_arena(tree.alloc_, n);
+        tree.root = build(first, n, tree.alloc_);
+        tree.size_ = n;
+        return tree;
+    }
+
+    //! Método swap
+    /*! O método swap troca o conteúdo de duas árvores em O(1). */
+    void swap(AVLTree& other) noexcept {
+        std::swap(root, other.root);
+        std::swap(size_, other.size_);
+        std::swap(alloc_, other.alloc_);
+    }
+
     //! Método insert
-    /*! O método insert insere um dado na árvore. */
+    /*! O método insert insere um dado na árvore, rebalanceando o caminho. */
     void insert(const T& data) {
-        if (empty()) {
-            root = new Node(data);
-        } else {
-            root->insert(data);
-        }
-        size_++;
+        insert_value(data);
+    }
+
+    //! Método insert
+    /*! O método insert move um dado para a árvore, rebalanceando o
+     *  caminho. */
+    void insert(T&& data) {
+        insert_value(std::move(data));
+    }
+
+    //! Método emplace
+    /*! O método emplace insere um dado construído a partir dos argumentos. */
+    template<typename... Args>
+    void emplace(Args&&... args) {
+        insert_value(std::forward<Args>(args)...);
     }
 
     //! Método remove
-    /*! O método remove excluiu um dado da árvore. */
+    /*! O método remove excluiu um dado da árvore, rebalanceando o caminho. */
     void remove(const T& data) {
-        if (!empty()) {
-            size_--;
-            root->remove(data);
+        Node **path[MAX_HEIGHT];
+        std::size_t depth = 0;
+        Node **link = &root;
+        while (*link != nullptr && !((*link)->data == data)) {
+            path[depth++] = link;
+            link = (data < (*link)->data ? &(*link)->left : &(*link)->right);
+        }
+        Node *n = *link;
+        if (n == nullptr) {
+            return;
+        }
+        if ((n->left != nullptr) && (n->right != nullptr)) {
+            std::size_t top = depth;
+            path[depth++] = link;
+            Node **min = &n->right;
+            while ((*min)->left != nullptr) {
+                path[depth++] = min;
+                min = &(*min)->left;
+            }
+            Node *m = *min;
+            *min = m->right;
+            m->left = n->left;
+            m->right = n->right;
+            m->height = n->height;
+            *link = m;
+            if (depth > top+1) {
+                path[top+1] = &m->right;  // o sucessor ocupa o lugar de n
+            }
+        } else {
+            *link = (n->left != nullptr ? n->left : n->right);
         }
+        dispose(alloc_, n);
+        size_--;
+        rebalance(path, depth);
     }
 
     //! Método contains
     /*! O método contains verifica se um dado existe na árvore. */
     bool contains(const T& data) const {
-        if (!empty()) {
-            return root->contains(data);
+        const Node *n = root;
+        while (n != nullptr) {
+            if (data == n->data) {
+                return true;
+            }
+            n = (data < n->data ? n->left : n->right);
         }
         return false;
     }
@@ -64,177 +206,860 @@ class AVLTree {
     //! Método pre_order
     /*! O método pre_order adiciona o dado antes de ordenar a árvore. */
     ArrayList<T> pre_order() const {
-        structures::ArrayList<T> v{};
-        if (!empty()) {
-            root->pre_order(v);
-        }
+        structures::ArrayList<T> v{size_, 2.0};
+        for_each_pre([&v](const T& data) {
+            v.push_back(data);
+            return true;
+        });
         return v;
     }
 
     //! Método in_order
     /*! O método in_order adiciona o dado durante a ordenação da árvore. */
     ArrayList<T> in_order() const {
-        structures::ArrayList<T> v{};
-        if (!empty()) {
-            root->in_order(v);
-        }
+        structures::ArrayList<T> v{size_, 2.0};
+        for_each_in([&v](const T& data) {
+            v.push_back(data);
+            return true;
+        });
         return v;
     }
 
     //! Método post_order
     /*! O método post_order adiciona o dado depois de ordenar a árvore. */
     ArrayList<T> post_order() const {
-        structures::ArrayList<T> v{};
-        if (!empty()) {
-            root->post_order(v);
-        }
+        structures::ArrayList<T> v{size_, 2.0};
+        for_each_post([&v](const T& data) {
+            v.push_back(data);
+            return true;
+        });
         return v;
     }
 
- private:
-    struct Node {
-        explicit Node(const T& data) : data{data}, left{nullptr}, right{nullptr}
-        {}
+    //! Método for_each_pre
+    /*! O método for_each_pre entrega os dados ao visitante em pré-ordem,
+     *  sem copiá-los. O visitante retorna false para interromper o percurso;
+     *  o método retorna se o percurso chegou ao fim. */
+    template<typename Visitor>
+    bool for_each_pre(Visitor visit) const {
+        NodeStack stack;
+        if (root != nullptr) {
+            stack.push_back(root);
+        }
+        while (!stack.empty()) {
+            const Node *n = stack.pop_back();
+            if (!visit(n->data)) {
+                return false;
+            }
+            if (n->right != nullptr) {
+                stack.push_back(n->right);
+            }
+            if (n->left != nullptr) {
+                stack.push_back(n->left);
+            }
+        }
+        return true;
+    }
 
-        T data;
-        std::size_t height;
-        Node* left;
-        Node* right;
+    //! Método for_each_in
+    /*! O método for_each_in entrega os dados ao visitante em ordem. */
+    template<typename Visitor>
+    bool for_each_in(Visitor visit) const {
+        NodeStack stack;
+        const Node *n = root;
+        while (n != nullptr || !stack.empty()) {
+            while (n != nullptr) {
+                stack.push_back(n);
+                n = n->left;
+            }
+            n = stack.pop_back();
+            if (!visit(n->data)) {
+                return false;
+            }
+            n = n->right;
+        }
+        return true;
+    }
 
-        void insert(const T& data_) {
-            Node *n;
-            if (data_ < this->data) {
-                if (this->left == nullptr) {
-                    n = new Node(data_);
-                    n->left = nullptr;
-                    n->right = nullptr;
-                    this->left = n;
-                } else {
-                    left->insert(data_);
-                }
+    //! Método for_each_post
+    /*! O método for_each_post entrega os dados ao visitante em pós-ordem. */
+    template<typename Visitor>
+    bool for_each_post(Visitor visit) const {
+        NodeStack stack;
+        const Node *n = root, *last = nullptr;
+        while (n != nullptr || !stack.empty()) {
+            while (n != nullptr) {
+                stack.push_back(n);
+                n = n->left;
+            }
+            const Node *top = stack[stack.size()-1];
+            if (top->right != nullptr && top->right != last) {
+                n = top->right;
             } else {
-                if (this->right == nullptr) {
-                    n = new Node(data_);
-                    n->left = nullptr;
-                    n->right = nullptr;
-                    this->right = n;
-                } else {
-                    right->insert(data_);
+                if (!visit(top->data)) {
+                    return false;
                 }
+                last = stack.pop_back();
             }
         }
+        return true;
+    }  // last marca a subárvore direita já visitada
 
-        bool remove(const T& data_) {
-            if (data_ == this->data) {
-                if ((this->left != nullptr) && (this->right != nullptr)) {
-                    Node *n = this->right;
-                    while (n->left != nullptr) {
-                        n = n->left;
-                    }
-                    this->data = n->data;
-                    return right->remove(this->data);
-                } else {
-                    if (this->right != nullptr) {
-                        this->data = right->data;
-                        return right->remove(this->data);
-                    } else {
-                        if (this->left != nullptr) {
-                            this->data = left->data;
-                            return left->remove(this->data);
-                        } else {
-                            delete this;
-                            return true;
-                        }
-                    }
-                }
+    //! Método begin
+    /*! O método begin retorna um iterador para o menor dado. */
+    const_iterator begin() const {
+        const_iterator it(root);
+        if (root != nullptr) {
+            it.start();
+            it.leftmost();
+        }
+        return it;
+    }
+
+    //! Método end
+    /*! O método end retorna o iterador que sucede o maior dado. */
+    const_iterator end() const {
+        return const_iterator(root);
+    }
+
+    //! Método lower_bound
+    /*! O método lower_bound retorna um iterador para o primeiro dado que não
+     *  é menor que data, ou end() se não houver. */
+    const_iterator lower_bound(const T& data) const {
+        return seek_first([&data](const T& x) { return x < data; });
+    }
+
+    //! Método upper_bound
+    /*! O método upper_bound retorna um iterador para o primeiro dado maior
+     *  que data, ou end() se não houver. */
+    const_iterator upper_bound(const T& data) const {
+        return seek_first([&data](const T& x) { return !(data < x); });
+    }
+
+    //! Método ceiling
+    /*! O método ceiling retorna um iterador para o menor dado maior ou igual
+     *  a data, ou end() se não houver. */
+    const_iterator ceiling(const T& data) const {
+        return lower_bound(data);
+    }
+
+    //! Método floor
+    /*! O método floor retorna um iterador para o maior dado menor ou igual a
+     *  data, ou end() se não houver. */
+    const_iterator floor(const T& data) const {
+        return seek_last([&data](const T& x) { return data < x; });
+    }
+
+    //! Método select
+    /*! O método select retorna o k-ésimo menor dado, contando de zero.
+     *  Exige Counted = true. */
+    const T& select(std::size_t k) const {
+        static_assert(Counted, "select exige AVLTree com Counted = true.");
+        if (k >= size_) {
+            throw(std::out_of_range("O índice é inválido."));
+        }
+        const Node *n = root;
+        for (;;) {
+            std::size_t left = Node::subtree_count(n->left);
+            if (k < left) {
+                n = n->left;
+            } else if (k == left) {
+                return n->data;
             } else {
-                if (this->right != nullptr && this->data < data_) {
-                    return right->remove(data_);
-                } else if (this->left != nullptr && this->data > data_) {
-                    return left->remove(data_);
-                }
+                k -= left+1;
+                n = n->right;
             }
-            return false;
         }
+    }
 
-        bool contains(const T& data_) const {
-            if (data_ == this->data) {
-                return true;
+    //! Método rank
+    /*! O método rank retorna quantos dados da árvore são menores que data.
+     *  Exige Counted = true. */
+    std::size_t rank(const T& data) const {
+        static_assert(Counted, "rank exige AVLTree com Counted = true.");
+        std::size_t r = 0;
+        for (const Node *n = root; n != nullptr;) {
+            if (n->data < data) {
+                r += Node::subtree_count(n->left) + 1;
+                n = n->right;
             } else {
-                if ((this->left != nullptr) && (data_ < this->data)) {
-                    return left->contains(data_);
-                } else if ((this->right != nullptr) && (data_ > this->data)) {
-                    return right->contains(data_);
-                }
+                n = n->left;
             }
-            return false;
+        }
+        return r;
+    }
+
+    //! Método count_range
+    /*! O método count_range retorna quantos dados estão em [first, last).
+     *  Exige Counted = true. */
+    std::size_t count_range(const T& first, const T& last) const {
+        if (!(first < last)) {
+            return 0u;
+        }
+        return rank(last) - rank(first);
+    }
+
+    //! Método range
+    /*! O método range retorna uma visão preguiçosa dos dados em [first, last).
+     *  Criá-la custa O(log n) e percorrê-la visita só os k dados do
+     *  intervalo. */
+    Range range(const T& first, const T& last) const {
+        const_iterator begin = lower_bound(first);
+        if (!(first < last)) {
+            return Range(begin, begin);
+        }
+        return Range(begin, lower_bound(last));
+    }
+
+    //! Método freeze
+    /*! O método freeze retorna uma cópia imutável e contígua da árvore, em
+     *  ordem de Eytzinger, para buscas rápidas quando ela não muda mais. */
+    FrozenTree<T> freeze() const {
+        return FrozenTree<T>(begin(), size_);
+    }
+
+    //! Método join
+    /*! O método join anexa os dados de other, que não podem ser menores que
+     *  os desta árvore, em O(log n). other fica vazia. */
+    void join(AVLTree& other) {
+        if (other.empty()) {
+            return;
+        }
+        if (!empty() && *other.begin() < *--end()) {
+            throw(std::out_of_range("Os dados não estão em ordem."));
+        }
+        std::size_t n = other.size_;
+        Node *right = adopt(other);
+        root = join(root, right);
+        size_ += n;
+    }
+
+    //! Método split
+    /*! O método split move para a árvore retornada os dados maiores ou
+     *  iguais a data, mantendo nesta os menores, em O(log n). Sem Counted,
+     *  acertar os tamanhos custa O(k), com k o tamanho da parte retornada. */
+    AVLTree split(const T& data) {
+        AVLTree greater;
+        greater.alloc_ = alloc_;
+        Node *less;
+        split(root, [&data](const T& x) { return x < data; },
+              less, greater.root);
+        root = less;
+        greater.size_ = count_nodes(greater.root);
+        size_ -= greater.size_;
+        return greater;
+    }
+
+    //! Método union_with
+    /*! O método union_with acrescenta os dados de other cujas chaves não estão
+     *  nesta árvore. Os métodos de conjunto consideram árvores sem dados
+     *  repetidos, custam O(m log(n/m + 1)) e dividem o trabalho entre
+     *  threads nas árvores grandes. Uma other constante é copiada uma vez,
+     *  direto para o alocador desta árvore; uma other temporária cede os
+     *  nodos, copiados só se os alocadores forem diferentes. */
+    void union_with(const AVLTree& other) {
+        combine_with(clone(other.root, alloc_), other.size_, SetOp::UNION);
+    }
+
+    //! Método union_with
+    /*! O método union_with acrescenta os dados de other, tomando seus
+     *  nodos. */
+    void union_with(AVLTree&& other) {
+        std::size_t n = other.size_;
+        combine_with(adopt(other), n, SetOp::UNION);
+    }
+
+    //! Método intersect
+    /*! O método intersect mantém só os dados cujas chaves estão em other. */
+    void intersect(const AVLTree& other) {
+        combine_with(clone(other.root, alloc_), other.size_,
+                     SetOp::INTERSECTION);
+    }
+
+    //! Método intersect
+    /*! O método intersect mantém só os dados cujas chaves estão em other,
+     *  tomando seus nodos. */
+    void intersect(AVLTree&& other) {
+        std::size_t n = other.size_;
+        combine_with(adopt(other), n, SetOp::INTERSECTION);
+    }
+
+    //! Método difference
+    /*! O método difference exclui os dados cujas chaves estão em other. */
+    void difference(const AVLTree& other) {
+        combine_with(clone(other.root, alloc_), other.size_,
+                     SetOp::DIFFERENCE);
+    }
+
+    //! Método difference
+    /*! O método difference exclui os dados cujas chaves estão em other,
+     *  tomando seus nodos. */
+    void difference(AVLTree&& other) {
+        std::size_t n = other.size_;
+        combine_with(adopt(other), n, SetOp::DIFFERENCE);
+    }
+
+ private:
+    using NodeAlloc =
+        typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAlloc>;
+
+    template<typename... Args>
+    static Node* create(NodeAlloc& alloc, Args&&... args) {
+        Node *n = NodeTraits::allocate(alloc, 1);
+        try {
+            NodeTraits::construct(alloc, n, std::forward<Args>(args)...);
+        } catch (...) {
+            NodeTraits::deallocate(alloc, n, 1);
+            throw;
+        }
+        return n;
+    }  // nodo construído na memória do alocador
+
+    static void dispose(NodeAlloc& alloc, Node* n) {
+        NodeTraits::destroy(alloc, n);
+        NodeTraits::deallocate(alloc, n, 1);
+    }
+
+    struct Node : SubtreeCount<Counted> {
+        template<typename... Args>
+        explicit Node(Args&&... args) :
+            data(std::forward<Args>(args)...),
+            height{0u},
+            left{nullptr},
+            right{nullptr}
+        {}
+
+        T data;
+        std::size_t height;
+        Node* left;
+        Node* right;
+
+        int balanceFactor() const {
+            int hleft = (this->left ? left->height : -1);
+            int hright = (this->right ? right->height : -1);
+            return hleft - hright;
         }
 
         void updateHeight() {
             int hleft = (this->left ? left->height : -1);
             int hright = (this->right ? right->height : -1);
             this->height = (hleft > hright ? hleft : hright)+1;
+            this->count(subtree_count(left) + subtree_count(right) + 1);
+        }  // atualiza também a contagem, quando houver
+
+        static std::size_t subtree_count(const Node* k) {
+            return (k != nullptr ? k->count() : 0u);
         }
 
-        Node* simpleLeft(Node *k2) {
+        Node* balance() {
+            updateHeight();
+            int factor = balanceFactor();
+            if (factor > 1) {
+                if (left->balanceFactor() >= 0) {
+                    return simpleLeft(this);
+                }
+                return doubleLeft(this);
+            }
+            if (factor < -1) {
+                if (right->balanceFactor() <= 0) {
+                    return simpleRight(this);
+                }
+                return doubleRight(this);
+            }
+            return this;
+        }  // aplica a rotação necessária e retorna a raiz
+
+        static Node* simpleLeft(Node *k2) {
             Node *k1 = k2->left;
             k2->left = k1->right;
             k1->right = k2;
             k2->updateHeight();
             k1->updateHeight();
+            return k1;
         }
 
-        Node* simpleRight(Node *k2) {
+        static Node* simpleRight(Node *k2) {
             Node *k1 = k2->right;
             k2->right = k1->left;
             k1->left = k2;
             k2->updateHeight();
             k1->updateHeight();
+            return k1;
         }
 
-        Node* doubleLeft(Node *k3) {
+        static Node* doubleLeft(Node *k3) {
             k3->left = simpleRight(k3->left);
             return simpleLeft(k3);
         }
 
-        Node* doubleRight(Node *k3) {
+        static Node* doubleRight(Node *k3) {
             k3->right = simpleLeft(k3->right);
             return simpleRight(k3);
         }
+    };
+
+    static const std::size_t MAX_HEIGHT = 96;  // acima de 2^64 nodos
+    using NodeStack = ArrayList<const Node*, MAX_HEIGHT>;
+
+    class Iterator {  // guarda o nodo e, num bit por nível, o caminho até ele
+     public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        Iterator() = default;
+
+        reference operator*() const {
+            return node_->data;
+        }
+
+        pointer operator->() const {
+            return &node_->data;
+        }
 
-        void pre_order(ArrayList<T>& v) const {
-            v.push_back(this->data);
-            if (this->left != nullptr) {
-                left->pre_order(v);
+        Iterator& operator++() {
+            if (node_->right != nullptr) {
+                down(true);
+                leftmost();
+            } else {
+                unsigned depth = depth_;
+                while (depth > 0 && went_right(depth-1)) {
+                    depth--;
+                }
+                up(depth);
             }
-            if (this->right != nullptr) {
-                right->pre_order(v);
+            return *this;
+        }  // sobe até o último ancestral de onde desceu à esquerda
+
+        Iterator operator++(int) {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        Iterator& operator--() {
+            if (node_ == nullptr) {
+                start();
+                rightmost();
+            } else if (node_->left != nullptr) {
+                down(false);
+                rightmost();
+            } else {
+                unsigned depth = depth_;
+                while (depth > 0 && !went_right(depth-1)) {
+                    depth--;
+                }
+                up(depth);
+            }
+            return *this;
+        }  // a partir do fim, desce até o maior dado
+
+        Iterator operator--(int) {
+            Iterator old = *this;
+            --*this;
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return node_ == other.node_;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return node_ != other.node_;
+        }
+
+     private:
+        friend class AVLTree;
+
+        static_assert(MAX_HEIGHT <= 128, "O caminho cabe em dois uint64_t.");
+
+        explicit Iterator(const Node* root):
+            root_{root}
+        {}
+
+        void start() {
+            node_ = root_;
+            depth_ = 0;
+        }
+
+        void down(bool right) {
+            std::uint64_t bit = std::uint64_t{1} << (depth_ % 64);
+            if (right) {
+                turns_[depth_ / 64] |= bit;
+            } else {
+                turns_[depth_ / 64] &= ~bit;
             }
+            depth_++;
+            node_ = (right ? node_->right : node_->left);
         }
 
-        void in_order(ArrayList<T>& v) const {
-            if (this->left != nullptr) {
-                left->in_order(v);
+        void up(unsigned depth) {
+            if (depth == 0) {
+                node_ = nullptr;  // não há ancestral: fim
+                return;
             }
-            v.push_back(this->data);
-            if (this->right != nullptr) {
-                right->in_order(v);
+            depth_ = 0;
+            node_ = root_;
+            while (depth_ < depth-1) {
+                node_ = (went_right(depth_) ? node_->right : node_->left);
+                depth_++;
             }
+        }  // volta ao ancestral da profundidade depth-1, descendo da raiz
+
+        bool went_right(unsigned depth) const {
+            return (turns_[depth / 64] >> (depth % 64)) & 1u;
         }
 
-        void post_order(ArrayList<T>& v) const {
-            if (this->left != nullptr) {
-                left->post_order(v);
+        void leftmost() {
+            while (node_->left != nullptr) {
+                down(false);
             }
-            if (this->right != nullptr) {
-                right->post_order(v);
+        }
+
+        void rightmost() {
+            while (node_->right != nullptr) {
+                down(true);
             }
-            v.push_back(this->data);
         }
+
+        const Node* root_{nullptr};
+        const Node* node_{nullptr};  // nullptr no fim
+        std::uint64_t turns_[2]{};  // bit i: desceu à direita no nível i
+        unsigned depth_{0u};
+    };  // copiar custa O(1): nada de pilha, subir desce de novo da raiz
+
+    class Range {  // par de iteradores; os dados continuam na árvore
+     public:
+        const_iterator begin() const {
+            return first_;
+        }
+
+        const_iterator end() const {
+            return last_;
+        }
+
+        bool empty() const {
+            return first_ == last_;
+        }
+
+     private:
+        friend class AVLTree;
+
+        Range(const_iterator first, const_iterator last):
+            first_{std::move(first)},
+            last_{std::move(last)}
+        {}
+
+        const_iterator first_;
+        const_iterator last_;
     };
 
+    template<typename Before>
+    const_iterator seek_first(Before before) const {
+        const_iterator it(root), found(root);
+        if (root == nullptr) {
+            return found;
+        }
+        it.start();
+        for (;;) {
+            bool right = before(it.node_->data);
+            if (!right) {
+                found = it;
+            }
+            if ((right ? it.node_->right : it.node_->left) == nullptr) {
+                return found;
+            }
+            it.down(right);
+        }
+    }  // primeiro dado para o qual before é falso
+
+    template<typename After>
+    const_iterator seek_last(After after) const {
+        const_iterator it(root), found(root);
+        if (root == nullptr) {
+            return found;
+        }
+        it.start();
+        for (;;) {
+            bool left = after(it.node_->data);
+            if (!left) {
+                found = it;
+            }
+            if ((left ? it.node_->left : it.node_->right) == nullptr) {
+                return found;
+            }
+            it.down(!left);
+        }
+    }  // último dado para o qual after é falso
+
+    template<typename... Args>
+    void insert_value(Args&&... args) {
+        Node *n = create(alloc_, std::forward<Args>(args)...);
+        Node **path[MAX_HEIGHT];
+        std::size_t depth = 0;
+        Node **link = &root;
+        try {
+            while (*link != nullptr) {
+                path[depth++] = link;
+                link = (n->data < (*link)->data ? &(*link)->left
+                                                : &(*link)->right);
+            }
+        } catch (...) {
+            dispose(alloc_, n);
+            throw;
+        }
+        *link = n;
+        size_++;
+        rebalance(path, depth);
+    }  // constrói o nodo, desce guardando os pais e sobe rebalanceando
+
+    static void rebalance(Node*** path, std::size_t depth) {
+        while (depth > 0) {
+            Node **link = path[--depth];
+            Node *n = *link;
+            std::size_t height = n->height;
+            *link = n->balance();
+            if (!Counted && *link == n && n->height == height) {
+                break;
+            }
+        }
+    }  // sem contagem, para no primeiro nodo cuja altura não mudou
+
+    template<typename ForwardIt>
+    static Node* build(ForwardIt& first, std::size_t n, NodeAlloc& alloc) {
+        if (n == 0) {
+            return nullptr;
+        }
+        Node *left = build(first, n/2, alloc);
+        Node *k;
+        try {
+            k = create(alloc, *first);
+        } catch (...) {
+            dispose_all(alloc, left);
+            throw;
+        }
+        ++first;
+        k->left = left;
+        try {
+            k->right = build(first, n-1-n/2, alloc);
+        } catch (...) {
+            dispose_all(alloc, k);
+            throw;
+        }
+        k->updateHeight();
+        return k;
+    }  // consome n dados em ordem; a recursão tem profundidade log n
+
+    static Node* clone(const Node* k, NodeAlloc& alloc) {
+        Node *copy = nullptr;
+        ArrayList<std::pair<const Node*, Node**>, 64> stack;
+        stack.push_back(std::make_pair(k, &copy));
+        try {
+            while (!stack.empty()) {
+                std::pair<const Node*, Node**> top = stack.pop_back();
+                if (top.first != nullptr) {
+                    Node *n = create(alloc, top.first->data);
+                    n->height = top.first->height;
+                    n->count(top.first->count());
+                    *top.second = n;
+                    stack.push_back(std::make_pair(top.first->right,
+                                                   &n->right));
+                    stack.push_back(std::make_pair(top.first->left,
+                                                   &n->left));
+                }
+            }
+        } catch (...) {
+            dispose_all(alloc, copy);
+            throw;
+        }
+        return copy;
+    }  // cada par liga o nodo original ao ponteiro que receberá a cópia
+
+    static std::size_t dispose_all(NodeAlloc& alloc, Node* k) {
+        std::size_t n = 0;
+        while (k != nullptr) {
+            if (k->left != nullptr) {
+                Node *left = k->left;
+                k->left = left->right;
+                left->right = k;
+                k = left;
+            } else {
+                Node *right = k->right;
+                dispose(alloc, k);
+                k = right;
+                n++;
+            }
+        }
+        return n;
+    }  // rotaciona à direita até a raiz não ter filho esquerdo; O(n), sem pilha
+
+    static int height(const Node* k) {
+        return (k != nullptr ? k->height : -1);
+    }
+
+    static std::size_t count_nodes(const Node* k) {
+        if (Counted) {
+            return Node::subtree_count(k);
+        }
+        std::size_t n = 0;
+        NodeStack stack;
+        if (k != nullptr) {
+            stack.push_back(k);
+        }
+        while (!stack.empty()) {
+            k = stack.pop_back();
+            n++;
+            if (k->left != nullptr) {
+                stack.push_back(k->left);
+            }
+            if (k->right != nullptr) {
+                stack.push_back(k->right);
+            }
+        }
+        return n;
+    }
+
+    static Node* join(Node* left, Node* k, Node* right) {
+        if (height(left) > height(right)+1) {
+            left->right = join(left->right, k, right);
+            return left->balance();
+        }
+        if (height(right) > height(left)+1) {
+            right->left = join(left, k, right->left);
+            return right->balance();
+        }
+        k->left = left;
+        k->right = right;
+        k->updateHeight();
+        return k;
+    }  // left <= k <= right; desce pelo lado da árvore mais alta
+
+    static Node* join(Node* left, Node* right) {
+        if (left == nullptr) {
+            return right;
+        }
+        Node *last;
+        left = split_last(left, last);
+        return join(left, last, right);
+    }
+
+    static Node* split_last(Node* k, Node*& last) {
+        if (k->right == nullptr) {
+            last = k;
+            return k->left;
+        }
+        Node *rest = split_last(k->right, last);
+        return join(k->left, k, rest);
+    }  // desliga o maior nodo da subárvore
+
+    template<typename Before>
+    static void split(Node* k, Before before, Node*& less, Node*& rest) {
+        if (k == nullptr) {
+            less = rest = nullptr;
+            return;
+        }
+        Node *left = k->left, *right = k->right;
+        if (before(k->data)) {
+            Node *middle;
+            split(right, before, middle, rest);
+            less = join(left, k, middle);
+        } else {
+            Node *middle;
+            split(left, before, less, middle);
+            rest = join(middle, k, right);
+        }
+    }  // less recebe os dados para os quais before é verdadeiro
+
+    Node* adopt(AVLTree& other) {
+        Node *k = other.root;
+        if (!(alloc_ == other.alloc_)) {
+            k = clone(other.root, alloc_);
+            dispose_all(other.alloc_, other.root);
+        }
+        other.root = nullptr;
+        other.size_ = 0;
+        return k;
+    }  // nodos de outro alocador são copiados para o desta árvore
+
+    enum class SetOp { UNION, INTERSECTION, DIFFERENCE };
+
+    static const int PARALLEL_HEIGHT = 16;  // subárvores com milhares de nodos
+
+    void combine_with(Node* k, std::size_t n, SetOp op) {
+        std::size_t total = size_ + n, dropped = 0;
+        root = combine(root, k, op, fork_depth(), alloc_, dropped);
+        size_ = total - dropped;
+    }  // k já está no alocador desta árvore e tem n nodos
+
+    static unsigned fork_depth() {
+        if (!std::is_same<NodeAlloc, std::allocator<Node>>::value) {
+            return 0u;  // as arenas não são thread-safe
+        }
+        unsigned depth = 0u;
+        for (unsigned t = std::thread::hardware_concurrency(); t > 1; t /= 2) {
+            depth++;
+        }
+        return depth;
+    }  // cada nível de recursão paralela dobra o número de threads
+
+    static Node* combine(Node* a, Node* b, SetOp op, unsigned forks,
+                         NodeAlloc& alloc, std::size_t& dropped) {
+        if (a == nullptr || b == nullptr) {
+            if (op == SetOp::UNION) {
+                return (a != nullptr ? a : b);
+            }
+            dropped += dispose_all(alloc, b);
+            if (op == SetOp::INTERSECTION) {
+                dropped += dispose_all(alloc, a);
+                return nullptr;
+            }
+            return a;
+        }
+        const T& key = a->data;
+        Node *less, *rest, *equal, *greater;
+        split(b, [&key](const T& x) { return x < key; }, less, rest);
+        split(rest, [&key](const T& x) { return !(key < x); }, equal, greater);
+        bool found = (equal != nullptr);
+        dropped += dispose_all(alloc, equal);
+
+        Node *left = a->left, *right = a->right;
+        std::size_t dropped_right = 0;
+        unsigned next = (forks > 0 ? forks-1 : 0u);
+        std::future<Node*> task;
+        if (forks > 0 && height(a) >= PARALLEL_HEIGHT) {
+            try {
+                task = std::async(std::launch::async,
+                                  [=, &alloc, &dropped_right]() {
+                    return combine(right, greater, op, next, alloc,
+                                   dropped_right);
+                });
+            } catch (const std::system_error&) {
+            }  // sem thread disponível, segue sequencial
+        }
+        left = combine(left, less, op, next, alloc, dropped);
+        if (task.valid()) {
+            right = task.get();
+        } else {
+            right = combine(right, greater, op, next, alloc, dropped_right);
+        }
+        dropped += dropped_right;
+
+        bool keep = (op == SetOp::UNION) ||
+                    (found == (op == SetOp::INTERSECTION));
+        if (keep) {
+            return join(left, a, right);
+        }
+        dispose(alloc, a);
+        dropped++;
+        return join(left, right);
+    }  // divide b pela raiz de a e resolve as metades, em paralelo se der
+
     Node* root{nullptr};
     std::size_t size_{0u};
+    NodeAlloc alloc_;
 };
 
 }  // namespace structures
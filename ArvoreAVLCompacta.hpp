@@ -0,0 +1,380 @@
+#ifndef STRUCTURES_COMPACT_AVL_TREE_H
+#define STRUCTURES_COMPACT_AVL_TREE_H
+
+#include <cstdint>  // std::size_t, std::uint8_t, std::uint32_t
+#include <new>  // placement new
+#include <stdexcept>  // C++ exceptions
+#include <type_traits>  // std::is_nothrow_move_constructible
+#include <utility>  // std::move, std::forward, std::swap
+
+#include "array_list.h"
+
+namespace structures {
+
+//! Classe CompactAVLTree
+/*! A classe CompactAVLTree é uma árvore AVL cujos nodos ficam todos num
+ *  único vetor contíguo. Os filhos são índices de 32 bits e a altura ocupa
+ *  um byte, então um nodo de int ocupa 16 bytes em vez de 32, e as buscas
+ *  percorrem memória próxima. Os dados removidos são destruídos na hora e
+ *  suas posições vão para uma lista livre, para serem reaproveitadas.
+ *  Copiar a árvore copia um só vetor. */
+
+template<typename T>
+class CompactAVLTree {
+ public:
+    CompactAVLTree():
+        nodes_{DEFAULT_CAPACITY, 2.0}
+    {}
+
+    explicit CompactAVLTree(std::size_t capacity):
+        nodes_{capacity, 2.0}
+    {}  // reserva espaço para capacity nodos
+
+    CompactAVLTree(const CompactAVLTree& other) = default;  // copia o vetor
+
+    CompactAVLTree(CompactAVLTree&& other) noexcept:
+        nodes_{std::move(other.nodes_)},
+        root_{other.root_},
+        free_{other.free_},
+        size_{other.size_}
+    {
+        other.root_ = NIL;
+        other.free_ = NIL;
+        other.size_ = 0;
+    }  // toma o vetor de other
+
+    CompactAVLTree& operator=(CompactAVLTree other) {
+        swap(other);
+        return *this;
+    }  // cópia ou movimento conforme o argumento
+
+    //! Método swap
+    /*! O método swap troca o conteúdo de duas árvores em O(1). */
+    void swap(CompactAVLTree& other) {
+        nodes_.swap(other.nodes_);
+        std::swap(root_, other.root_);
+        std::swap(free_, other.free_);
+        std::swap(size_, other.size_);
+    }
+
+    //! Método insert
+    /*! O método insert insere um dado na árvore, rebalanceando o caminho. */
+    void insert(const T& data) {
+        root_ = insert(root_, data);
+        size_++;
+    }
+
+    //! Método insert
+    /*! O método insert move um dado para a árvore, rebalanceando o
+     *  caminho. */
+    void insert(T&& data) {
+        root_ = insert(root_, std::move(data));
+        size_++;
+    }
+
+    //! Método emplace
+    /*! O método emplace insere um dado construído a partir dos argumentos. */
+    template<typename... Args>
+    void emplace(Args&&... args) {
+        insert(T(std::forward<Args>(args)...));
+    }
+
+    //! Método remove
+    /*! O método remove exclui um dado da árvore, rebalanceando o caminho. */
+    void remove(const T& data) {
+        bool removed = false;
+        root_ = remove(root_, data, removed);
+        if (removed) {
+            size_--;
+        }
+    }
+
+    //! Método contains
+    /*! O método contains verifica se um dado existe na árvore. */
+    bool contains(const T& data) const {
+        std::uint32_t k = root_;
+        while (k != NIL) {
+            const Node& n = nodes_[k];
+            if (data < n.data) {
+                k = n.left;
+            } else if (n.data < data) {
+                k = n.right;
+            } else {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //! Método clear
+    /*! O método clear apaga os dados da árvore, mantendo o vetor alocado. */
+    void clear() {
+        nodes_.clear();
+        root_ = NIL;
+        free_ = NIL;
+        size_ = 0;
+    }
+
+    //! Método reserve
+    /*! O método reserve garante espaço para ao menos capacity nodos. */
+    void reserve(std::size_t capacity) {
+        nodes_.reserve(capacity);
+    }
+
+    //! Método empty
+    /*! O método empty verifica se a árvore está vazia. */
+    bool empty() const {
+        return (size_ == 0);
+    }
+
+    //! Método size
+    /*! O método size retorna o tamanho da árvore. */
+    std::size_t size() const {
+        return size_;
+    }
+
+    //! Método pre_order
+    /*! O método pre_order adiciona o dado antes de ordenar a árvore. */
+    ArrayList<T> pre_order() const {
+        structures::ArrayList<T> v{size_, 2.0};
+        pre_order(root_, v);
+        return v;
+    }
+
+    //! Método in_order
+    /*! O método in_order adiciona o dado durante a ordenação da árvore. */
+    ArrayList<T> in_order() const {
+        structures::ArrayList<T> v{size_, 2.0};
+        in_order(root_, v);
+        return v;
+    }
+
+    //! Método post_order
+    /*! O método post_order adiciona o dado depois de ordenar a árvore. */
+    ArrayList<T> post_order() const {
+        structures::ArrayList<T> v{size_, 2.0};
+        post_order(root_, v);
+        return v;
+    }
+
+ private:
+    static const std::uint32_t NIL = 0xFFFFFFFFu;  // filho ausente
+    static const auto DEFAULT_CAPACITY = 16u;
+    static const std::uint8_t FREE = 0xFFu;  // altura de uma posição vaga
+
+    struct Node {
+        explicit Node(const T& data_) {
+            new (&data) T(data_);
+        }
+
+        explicit Node(T&& data_) {
+            new (&data) T(std::move(data_));
+        }
+
+        Node(const Node& other):
+            left{other.left},
+            right{other.right},
+            height{other.height}
+        {
+            if (other.height != FREE) {
+                new (&data) T(other.data);
+            }
+        }
+
+        Node(Node&& other) noexcept(
+            std::is_nothrow_move_constructible<T>::value):
+            left{other.left},
+            right{other.right},
+            height{other.height}
+        {
+            if (other.height != FREE) {
+                new (&data) T(std::move(other.data));
+            }
+        }
+
+        Node& operator=(const Node&) = delete;
+
+        ~Node() {
+            if (height != FREE) {
+                data.~T();
+            }
+        }
+
+        union {
+            T data;  // só existe enquanto a posição está ocupada
+        };
+        std::uint32_t left{NIL};
+        std::uint32_t right{NIL};  // na lista livre: não usado
+        std::uint8_t height{0u};
+    };  // na lista livre, left encadeia as posições vagas
+
+    template<typename U>
+    std::uint32_t make_node(U&& data) {
+        std::uint32_t k = free_;
+        if (k != NIL) {
+            Node& n = nodes_[k];
+            new (&n.data) T(std::forward<U>(data));  // se lançar, segue vaga
+            free_ = n.left;
+            n.left = NIL;
+            n.right = NIL;
+            n.height = 0u;
+            return k;
+        }
+        if (nodes_.size() >= NIL) {
+            throw(std::out_of_range("A árvore está cheia."));
+        }
+        nodes_.emplace_back(std::forward<U>(data));
+        return nodes_.size()-1;
+    }  // posição vaga da lista livre, ou uma nova no fim do vetor
+
+    void release_node(std::uint32_t k) {
+        Node& n = nodes_[k];
+        n.data.~T();
+        n.height = FREE;
+        n.left = free_;
+        free_ = k;
+    }  // o dado é destruído já; a posição vaga só guarda o encadeamento
+
+    template<typename U>
+    std::uint32_t insert(std::uint32_t k, U&& data) {
+        if (k == NIL) {
+            return make_node(std::forward<U>(data));
+        }
+        if (data < nodes_[k].data) {
+            std::uint32_t child = insert(nodes_[k].left, std::forward<U>(data));
+            nodes_[k].left = child;  // o vetor pode ter sido realocado
+        } else {
+            std::uint32_t child = insert(nodes_[k].right,
+                                         std::forward<U>(data));
+            nodes_[k].right = child;
+        }
+        return balance(k);
+    }  // retorna a nova raiz da subárvore
+
+    std::uint32_t remove(std::uint32_t k, const T& data, bool& removed) {
+        if (k == NIL) {
+            return NIL;
+        }
+        Node& n = nodes_[k];
+        if (data < n.data) {
+            n.left = remove(n.left, data, removed);
+        } else if (n.data < data) {
+            n.right = remove(n.right, data, removed);
+        } else {
+            removed = true;
+            std::uint32_t left = n.left, right = n.right;
+            release_node(k);
+            if ((left != NIL) && (right != NIL)) {
+                std::uint32_t min;
+                std::uint32_t rest = remove_min(right, min);
+                nodes_[min].left = left;
+                nodes_[min].right = rest;
+                return balance(min);
+            }
+            return (left != NIL ? left : right);
+        }
+        return balance(k);
+    }  // retorna a nova raiz da subárvore
+
+    std::uint32_t remove_min(std::uint32_t k, std::uint32_t& min) {
+        if (nodes_[k].left == NIL) {
+            min = k;
+            return nodes_[k].right;
+        }
+        nodes_[k].left = remove_min(nodes_[k].left, min);
+        return balance(k);
+    }  // desliga o menor nodo da subárvore sem liberá-lo
+
+    int height(std::uint32_t k) const {
+        return (k != NIL ? nodes_[k].height : -1);
+    }
+
+    int balance_factor(std::uint32_t k) const {
+        return height(nodes_[k].left) - height(nodes_[k].right);
+    }
+
+    void update_height(std::uint32_t k) {
+        int hleft = height(nodes_[k].left);
+        int hright = height(nodes_[k].right);
+        nodes_[k].height = (hleft > hright ? hleft : hright)+1;
+    }
+
+    std::uint32_t balance(std::uint32_t k) {
+        update_height(k);
+        int factor = balance_factor(k);
+        if (factor > 1) {
+            if (balance_factor(nodes_[k].left) >= 0) {
+                return simple_left(k);
+            }
+            return double_left(k);
+        }
+        if (factor < -1) {
+            if (balance_factor(nodes_[k].right) <= 0) {
+                return simple_right(k);
+            }
+            return double_right(k);
+        }
+        return k;
+    }  // aplica a rotação necessária e retorna a raiz
+
+    std::uint32_t simple_left(std::uint32_t k2) {
+        std::uint32_t k1 = nodes_[k2].left;
+        nodes_[k2].left = nodes_[k1].right;
+        nodes_[k1].right = k2;
+        update_height(k2);
+        update_height(k1);
+        return k1;
+    }
+
+    std::uint32_t simple_right(std::uint32_t k2) {
+        std::uint32_t k1 = nodes_[k2].right;
+        nodes_[k2].right = nodes_[k1].left;
+        nodes_[k1].left = k2;
+        update_height(k2);
+        update_height(k1);
+        return k1;
+    }
+
+    std::uint32_t double_left(std::uint32_t k3) {
+        nodes_[k3].left = simple_right(nodes_[k3].left);
+        return simple_left(k3);
+    }
+
+    std::uint32_t double_right(std::uint32_t k3) {
+        nodes_[k3].right = simple_left(nodes_[k3].right);
+        return simple_right(k3);
+    }
+
+    void pre_order(std::uint32_t k, ArrayList<T>& v) const {
+        if (k != NIL) {
+            v.push_back(nodes_[k].data);
+            pre_order(nodes_[k].left, v);
+            pre_order(nodes_[k].right, v);
+        }
+    }
+
+    void in_order(std::uint32_t k, ArrayList<T>& v) const {
+        if (k != NIL) {
+            in_order(nodes_[k].left, v);
+            v.push_back(nodes_[k].data);
+            in_order(nodes_[k].right, v);
+        }
+    }
+
+    void post_order(std::uint32_t k, ArrayList<T>& v) const {
+        if (k != NIL) {
+            post_order(nodes_[k].left, v);
+            post_order(nodes_[k].right, v);
+            v.push_back(nodes_[k].data);
+        }
+    }
+
+    ArrayList<Node> nodes_;  // todos os nodos, vivos e vagos
+    std::uint32_t root_{NIL};
+    std::uint32_t free_{NIL};  // primeira posição vaga
+    std::size_t size_{0u};
+};
+
+}  // namespace structures
+
+#endif
@@ -3,6 +3,12 @@
 #ifndef BINARY_TREE_H
 #define BINARY_TREE_H
 
+#include <cstddef>  // std::ptrdiff_t
+#include <iterator>  // std::bidirectional_iterator_tag, std::distance
+#include <memory>  // std::allocator, std::allocator_traits
+#include <utility>  // std::move, std::forward, std::swap, std::pair
+
+#include "./Alocador.hpp"
 #include "./array_list.h"
 
 namespace structures {
@@ -10,41 +16,127 @@ namespace structures {
 //! Classe BinaryTree
 /*! A classe BinaryTree é uma árvore binéria com busca de percursos. */
 
-template<typename T>
+template<typename T, typename Alloc = std::allocator<T>>
 class BinaryTree {
+    struct Node;
+    class Iterator;
+
  public:
+    using const_iterator = Iterator;
+    using iterator = const_iterator;  // os dados não podem ser alterados
+
     BinaryTree() = default;
 
+    explicit BinaryTree(const Alloc& alloc):
+        alloc_{alloc}
+    {}  // nodos alocados por alloc
+
+    BinaryTree(const BinaryTree& other):
+        size_{other.size_},
+        alloc_{NodeTraits::select_on_container_copy_construction(other.alloc_)}
+    {
+        root = clone(other.root, alloc_);
+    }  // cópia profunda, com a mesma forma
+
+    BinaryTree(BinaryTree&& other) noexcept:
+        root{other.root},
+        size_{other.size_},
+        alloc_{std::move(other.alloc_)}
+    {
+        other.root = nullptr;
+        other.size_ = 0;
+    }  // toma os nodos de other
+
+    BinaryTree& operator=(BinaryTree other) {
+        swap(other);
+        return *this;
+    }  // cópia ou movimento conforme o argumento
+
     virtual ~BinaryTree() {
-        delete root;
+        if (root != nullptr && !release_arena(alloc_)) {
+            dispose_all(alloc_, root);
+        }
         size_ = 0u;
     }
 
+    //! Método from_sorted
+    /*! O método from_sorted constrói uma árvore perfeitamente balanceada a
+     *  partir de um intervalo já ordenado, em O(n) e sem rotações. Com um
+     *  PoolAllocator, todos os nodos ficam num só bloco contíguo. */
+    template<typename ForwardIt>
+    static BinaryTree from_sorted(ForwardIt first, ForwardIt last,
+                                  const Alloc& alloc = Alloc()) {
+        BinaryTree tree(alloc);
+        std::size_t n = std::distance(first, last);
+        reserve_arena(tree.alloc_, n);
+        tree.root = build(first, n, tree.alloc_);
+        tree.size_ = n;
+        return tree;
+    }
+
+    //! Método swap
+    /*! O método swap troca o conteúdo de duas árvores em O(1). */
+    void swap(BinaryTree& other) noexcept {
+        std::swap(root, other.root);
+        std::swap(size_, other.size_);
+        std::swap(alloc_, other.alloc_);
+    }
+
     //! Método insert
     /*! O método insert insere um dado na árvore. */
     void insert(const T& data) {
-        if (empty()) {
-            root = new Node(data);
-        } else {
-            root->insert(data);
-        }
-        size_++;
+        insert_value(data);
+    }
+
+    //! Método insert
+    /*! O método insert move um dado para a árvore. */
+    void insert(T&& data) {
+        insert_value(std::move(data));
+    }
+
+    //! Método emplace
+    /*! O método emplace insere um dado construído a partir dos argumentos. */
+    template<typename... Args>
+    void emplace(Args&&... args) {
+        insert_value(std::forward<Args>(args)...);
     }
 
     //! Método remove
     /*! O método remove excluiu um dado da árvore. */
     void remove(const T& data) {
-        if (!empty()) {
-            size_--;
-            root->remove(data);
+        Node **link = &root;
+        while (*link != nullptr && !((*link)->data == data)) {
+            link = (data < (*link)->data ? &(*link)->left : &(*link)->right);
         }
-    }
+        Node *n = *link;
+        if (n == nullptr) {
+            return;
+        }
+        if ((n->left != nullptr) && (n->right != nullptr)) {
+            Node **min = &n->right;
+            while ((*min)->left != nullptr) {
+                min = &(*min)->left;
+            }
+            Node *m = *min;
+            n->data = std::move(m->data);
+            *min = m->right;
+            n = m;
+        } else {
+            *link = (n->left != nullptr ? n->left : n->right);
+        }
+        dispose(alloc_, n);
+        size_--;
+    }  // sobe o sucessor quando o nodo tem dois filhos
 
     //! Método contains
     /*! O método contains verifica se um dadp existe na árvore. */
     bool contains(const T& data) const {
-        if (!empty()) {
-            return root->contains(data);
+        const Node *n = root;
+        while (n != nullptr) {
+            if (data == n->data) {
+                return true;
+            }
+            n = (data < n->data ? n->left : n->right);
         }
         return false;
     }
@@ -64,144 +156,331 @@ class BinaryTree {
     //! Método pre_order
     /*! O método pre_order adiciona o dado antes de ordenar a árvore. */
     ArrayList<T> pre_order() const {
-        structures::ArrayList<T> v{};
-        if (!empty()) {
-            root->pre_order(v);
-        }
+        structures::ArrayList<T> v{size_, 2.0};
+        for_each_pre([&v](const T& data) {
+            v.push_back(data);
+            return true;
+        });
         return v;
     }
 
     //! Método in_order
     /*! O método in_order adiciona o dado durante a ordenação da árvore. */
     ArrayList<T> in_order() const {
-        structures::ArrayList<T> v{};
-        if (!empty()) {
-            root->in_order(v);
-        }
+        structures::ArrayList<T> v{size_, 2.0};
+        for_each_in([&v](const T& data) {
+            v.push_back(data);
+            return true;
+        });
         return v;
     }
 
     //! Método post_order
     /*! O método post_order adiciona o dado depois de ordenar a árvore. */
     ArrayList<T> post_order() const {
-        structures::ArrayList<T> v{};
-        if (!empty()) {
-            root->post_order(v);
-        }
+        structures::ArrayList<T> v{size_, 2.0};
+        for_each_post([&v](const T& data) {
+            v.push_back(data);
+            return true;
+        });
         return v;
     }
 
+    //! Método for_each_pre
+    /*! O método for_each_pre entrega os dados ao visitante em pré-ordem,
+     *  sem copiá-los. O visitante retorna false para interromper o percurso;
+     *  o método retorna se o percurso chegou ao fim. */
+    template<typename Visitor>
+    bool for_each_pre(Visitor visit) const {
+        NodeStack stack;
+        if (root != nullptr) {
+            stack.push_back(root);
+        }
+        while (!stack.empty()) {
+            const Node *n = stack.pop_back();
+            if (!visit(n->data)) {
+                return false;
+            }
+            if (n->right != nullptr) {
+                stack.push_back(n->right);
+            }
+            if (n->left != nullptr) {
+                stack.push_back(n->left);
+            }
+        }
+        return true;
+    }
+
+    //! Método for_each_in
+    /*! O método for_each_in entrega os dados ao visitante em ordem. */
+    template<typename Visitor>
+    bool for_each_in(Visitor visit) const {
+        NodeStack stack;
+        const Node *n = root;
+        while (n != nullptr || !stack.empty()) {
+            while (n != nullptr) {
+                stack.push_back(n);
+                n = n->left;
+            }
+            n = stack.pop_back();
+            if (!visit(n->data)) {
+                return false;
+            }
+            n = n->right;
+        }
+        return true;
+    }
+
+    //! Método for_each_post
+    /*! O método for_each_post entrega os dados ao visitante em pós-ordem. */
+    template<typename Visitor>
+    bool for_each_post(Visitor visit) const {
+        NodeStack stack;
+        const Node *n = root, *last = nullptr;
+        while (n != nullptr || !stack.empty()) {
+            while (n != nullptr) {
+                stack.push_back(n);
+                n = n->left;
+            }
+            const Node *top = stack[stack.size()-1];
+            if (top->right != nullptr && top->right != last) {
+                n = top->right;
+            } else {
+                if (!visit(top->data)) {
+                    return false;
+                }
+                last = stack.pop_back();
+            }
+        }
+        return true;
+    }  // last marca a subárvore direita já visitada
+
+    //! Método begin
+    /*! O método begin retorna um iterador para o menor dado. */
+    const_iterator begin() const {
+        const_iterator it(root);
+        it.descend_left(root);
+        return it;
+    }
+
+    //! Método end
+    /*! O método end retorna o iterador que sucede o maior dado. */
+    const_iterator end() const {
+        return const_iterator(root);
+    }
+
  private:
+    using NodeAlloc =
+        typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAlloc>;
+
+    template<typename... Args>
+    static Node* create(NodeAlloc& alloc, Args&&... args) {
+        Node *n = NodeTraits::allocate(alloc, 1);
+        try {
+            NodeTraits::construct(alloc, n, std::forward<Args>(args)...);
+        } catch (...) {
+            NodeTraits::deallocate(alloc, n, 1);
+            throw;
+        }
+        return n;
+    }  // nodo construído na memória do alocador
+
+    static void dispose(NodeAlloc& alloc, Node* n) {
+        NodeTraits::destroy(alloc, n);
+        NodeTraits::deallocate(alloc, n, 1);
+    }
+
     struct Node {
-        explicit Node(const T& data) : data{data}, left{nullptr}, right{nullptr}
+        template<typename... Args>
+        explicit Node(Args&&... args) :
+            data(std::forward<Args>(args)...),
+            left{nullptr},
+            right{nullptr}
         {}
 
         T data;
         Node* left;
         Node* right;
+    };
 
-        void insert(const T& data_) {
-            Node *n;
-            if (data_ < this->data) {
-                if (this->left == nullptr) {
-                    n = new Node(data_);
-                    n->left = nullptr;
-                    n->right = nullptr;
-                    this->left = n;
-                } else {
-                    left->insert(data_);
-                }
-            } else {
-                if (this->right == nullptr) {
-                    n = new Node(data_);
-                    n->left = nullptr;
-                    n->right = nullptr;
-                    this->right = n;
-                } else {
-                    right->insert(data_);
-                }
-            }
+    using NodeStack = ArrayList<const Node*, 64>;  // pilha dos percursos
+
+    class Iterator {  // guarda o caminho da raiz até o dado; vazio no fim
+     public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        Iterator() = default;
+
+        reference operator*() const {
+            return current()->data;
         }
 
-        bool remove(const T& data_) {
-            if (data_ == this->data) {
-                if ((this->left != nullptr) && (this->right != nullptr)) {
-                    Node *n = this->right;
-                    while (n->left != nullptr) {
-                        n = n->left;
-                    }
-                    this->data = n->data;
-                    return right->remove(this->data);
-                } else {
-                    if (this->right != nullptr) {
-                        this->data = right->data;
-                        return right->remove(this->data);
-                    } else {
-                        if (this->left != nullptr) {
-                            this->data = left->data;
-                            return left->remove(this->data);
-                        } else {
-                            delete this;
-                            return true;
-                        }
-                    }
-                }
+        pointer operator->() const {
+            return &current()->data;
+        }
+
+        Iterator& operator++() {
+            const Node *n = current();
+            if (n->right != nullptr) {
+                descend_left(n->right);
             } else {
-                if (this->right != nullptr && this->data < data_) {
-                    return right->remove(data_);
-                } else if (this->left != nullptr && this->data > data_) {
-                    return left->remove(data_);
-                }
+                do {
+                    n = path_.pop_back();
+                } while (!path_.empty() && current()->right == n);
             }
-            return false;
+            return *this;
+        }  // sobe até vir de um filho esquerdo
+
+        Iterator operator++(int) {
+            Iterator old = *this;
+            ++*this;
+            return old;
         }
 
-        bool contains(const T& data_) const {
-            if (data_ == this->data) {
-                return true;
+        Iterator& operator--() {
+            const Node *n = current();
+            if (n == nullptr) {
+                descend_right(root_);
+            } else if (n->left != nullptr) {
+                descend_right(n->left);
             } else {
-                if ((this->left != nullptr) && (data_ < this->data)) {
-                    return left->contains(data_);
-                } else if ((this->right != nullptr) && (data_ > this->data)) {
-                    return right->contains(data_);
-                }
+                do {
+                    n = path_.pop_back();
+                } while (!path_.empty() && current()->left == n);
             }
-            return false;
+            return *this;
+        }  // a partir do fim, desce até o maior dado
+
+        Iterator operator--(int) {
+            Iterator old = *this;
+            --*this;
+            return old;
         }
 
-        void pre_order(ArrayList<T>& v) const {
-            v.push_back(this->data);
-            if (this->left != nullptr) {
-                left->pre_order(v);
-            }
-            if (this->right != nullptr) {
-                right->pre_order(v);
+        bool operator==(const Iterator& other) const {
+            return current() == other.current();
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return current() != other.current();
+        }
+
+     private:
+        friend class BinaryTree;
+
+        explicit Iterator(const Node* root):
+            root_{root}
+        {}
+
+        const Node* current() const {
+            return (path_.empty() ? nullptr : path_[path_.size()-1]);
+        }
+
+        void descend_left(const Node* n) {
+            while (n != nullptr) {
+                path_.push_back(n);
+                n = n->left;
             }
         }
 
-        void in_order(ArrayList<T>& v) const {
-            if (this->left != nullptr) {
-                left->in_order(v);
+        void descend_right(const Node* n) {
+            while (n != nullptr) {
+                path_.push_back(n);
+                n = n->right;
             }
-            v.push_back(this->data);
-            if (this->right != nullptr) {
-                right->in_order(v);
+        }
+
+        const Node* root_{nullptr};
+        ArrayList<const Node*> path_{0u, 2.0};  // o fim não aloca
+    };  // sem balanço, o caminho fica no heap: copiar custa O(profundidade)
+
+    template<typename... Args>
+    void insert_value(Args&&... args) {
+        Node *n = create(alloc_, std::forward<Args>(args)...);
+        Node **link = &root;
+        try {
+            while (*link != nullptr) {
+                link = (n->data < (*link)->data ? &(*link)->left
+                                                : &(*link)->right);
             }
+        } catch (...) {
+            dispose(alloc_, n);
+            throw;
+        }
+        *link = n;
+        size_++;
+    }  // constrói o nodo e desce pelo ponteiro do pai até a posição vazia
+
+    template<typename ForwardIt>
+    static Node* build(ForwardIt& first, std::size_t n, NodeAlloc& alloc) {
+        if (n == 0) {
+            return nullptr;
+        }
+        Node *left = build(first, n/2, alloc);
+        Node *k;
+        try {
+            k = create(alloc, *first);
+        } catch (...) {
+            dispose_all(alloc, left);
+            throw;
         }
+        ++first;
+        k->left = left;
+        try {
+            k->right = build(first, n-1-n/2, alloc);
+        } catch (...) {
+            dispose_all(alloc, k);
+            throw;
+        }
+        return k;
+    }  // consome n dados em ordem; a recursão tem profundidade log n
 
-        void post_order(ArrayList<T>& v) const {
-            if (this->left != nullptr) {
-                left->post_order(v);
+    static Node* clone(const Node* k, NodeAlloc& alloc) {
+        Node *copy = nullptr;
+        ArrayList<std::pair<const Node*, Node**>, 64> stack;
+        stack.push_back(std::make_pair(k, &copy));
+        try {
+            while (!stack.empty()) {
+                std::pair<const Node*, Node**> top = stack.pop_back();
+                if (top.first != nullptr) {
+                    Node *n = create(alloc, top.first->data);
+                    *top.second = n;
+                    stack.push_back(std::make_pair(top.first->right,
+                                                   &n->right));
+                    stack.push_back(std::make_pair(top.first->left,
+                                                   &n->left));
+                }
             }
-            if (this->right != nullptr) {
-                right->post_order(v);
+        } catch (...) {
+            dispose_all(alloc, copy);
+            throw;
+        }
+        return copy;
+    }  // cada par liga o nodo original ao ponteiro que receberá a cópia
+
+    static void dispose_all(NodeAlloc& alloc, Node* k) {
+        while (k != nullptr) {
+            if (k->left != nullptr) {
+                Node *left = k->left;
+                k->left = left->right;
+                left->right = k;
+                k = left;
+            } else {
+                Node *right = k->right;
+                dispose(alloc, k);
+                k = right;
             }
-            v.push_back(this->data);
         }
-    };
+    }  // rotaciona à direita até a raiz não ter filho esquerdo; O(n), sem pilha
 
     Node* root{nullptr};
     std::size_t size_{0u};
+    NodeAlloc alloc_;
 };
 
 }  // namespace structures
@@ -0,0 +1,168 @@
+#ifndef STRUCTURES_FROZEN_TREE_H
+#define STRUCTURES_FROZEN_TREE_H
+
+#include <cstdint>  // std::size_t, std::uintptr_t
+#include <new>  // placement new, operator new
+#include <utility>  // std::move, std::swap
+
+namespace structures {
+
+//! Classe FrozenTree
+/*! A classe FrozenTree é uma cópia imutável de uma árvore de busca, com os
+ *  dados num único vetor em ordem de Eytzinger (a ordem de uma busca em
+ *  largura): os filhos da posição k ficam em 2k e 2k+1. A descida não tem
+ *  desvios, só um índice calculado a partir da comparação, e busca na
+ *  memória os nodos de alguns níveis abaixo enquanto compara os atuais. */
+
+template<typename T>
+class FrozenTree {
+ public:
+    FrozenTree() = default;
+
+    //! Construtor
+    /*! Constrói a cópia a partir dos size primeiros dados de first, que
+     *  precisam estar em ordem crescente. */
+    template<typename InputIt>
+    FrozenTree(InputIt first, std::size_t size) {
+        allocate(size);
+        std::size_t built = 0;
+        try {
+            fill(first, 1, built);
+        } catch (...) {
+            destroy_in_order(1, built);
+            ::operator delete(raw_);
+            throw;
+        }
+    }
+
+    FrozenTree(const FrozenTree& other) {
+        allocate(other.size_);
+        std::size_t k = 1;
+        try {
+            for (; k <= size_; k++) {
+                new (data_ + k) T(other.data_[k]);
+            }
+        } catch (...) {
+            while (--k > 0) {
+                data_[k].~T();
+            }
+            ::operator delete(raw_);
+            throw;
+        }
+    }
+
+    FrozenTree(FrozenTree&& other) noexcept {
+        swap(other);
+    }
+
+    FrozenTree& operator=(FrozenTree other) {
+        swap(other);
+        return *this;
+    }  // cópia ou movimento conforme o argumento
+
+    ~FrozenTree() {
+        for (std::size_t k = 1; k <= size_; k++) {
+            data_[k].~T();
+        }
+        ::operator delete(raw_);
+        raw_ = nullptr;
+        data_ = nullptr;
+        size_ = 0u;
+    }
+
+    //! Método swap
+    /*! O método swap troca o conteúdo de duas cópias em O(1). */
+    void swap(FrozenTree& other) noexcept {
+        std::swap(raw_, other.raw_);
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+    }
+
+    //! Método contains
+    /*! O método contains verifica se um dado existe na cópia. */
+    bool contains(const T& data) const {
+        std::size_t k = lower_bound_index(data);
+        return (k != 0) && !(data < data_[k]);
+    }
+
+    //! Método lower_bound
+    /*! O método lower_bound retorna o menor dado que não é menor que data,
+     *  ou nullptr se não houver. */
+    const T* lower_bound(const T& data) const {
+        std::size_t k = lower_bound_index(data);
+        return (k != 0 ? data_ + k : nullptr);
+    }
+
+    //! Método empty
+    /*! O método empty verifica se a cópia está vazia. */
+    bool empty() const {
+        return (size_ == 0);
+    }
+
+    //! Método size
+    /*! O método size retorna o tamanho da cópia. */
+    std::size_t size() const {
+        return size_;
+    }
+
+ private:
+    static const std::size_t LINE = 64u;  // bytes de uma linha de cache
+    static const std::size_t AHEAD = 16u;  // 16 descendentes: 4 níveis
+
+    void allocate(std::size_t size) {
+        raw_ = ::operator new((size+1)*sizeof(T) + LINE);
+        std::uintptr_t p = reinterpret_cast<std::uintptr_t>(raw_);
+        p = (p + LINE-1) & ~static_cast<std::uintptr_t>(LINE-1);
+        data_ = reinterpret_cast<T*>(p);
+        size_ = size;
+    }  // a posição 0 não é usada; o vetor começa numa linha de cache
+
+    template<typename InputIt>
+    void fill(InputIt& first, std::size_t k, std::size_t& built) {
+        if (k <= size_) {
+            fill(first, 2*k, built);
+            new (data_ + k) T(*first);
+            ++first;
+            built++;
+            fill(first, 2*k+1, built);
+        }
+    }  // percurso em ordem da árvore implícita; profundidade log n
+
+    void destroy_in_order(std::size_t k, std::size_t& count) {
+        if (k <= size_ && count > 0) {
+            destroy_in_order(2*k, count);
+            if (count > 0) {
+                data_[k].~T();
+                count--;
+                destroy_in_order(2*k+1, count);
+            }
+        }
+    }  // destrói os count primeiros dados construídos por fill
+
+    std::size_t lower_bound_index(const T& data) const {
+        std::size_t k = 1;
+        while (k <= size_) {
+#if defined(__GNUC__)
+            __builtin_prefetch(data_ + k*AHEAD);
+#endif
+            k = 2*k + (data_[k] < data);
+        }
+#if defined(__GNUC__)
+        k >>= __builtin_ffsll(~static_cast<unsigned long long>(k));
+#else
+        while (k & 1u) {
+            k >>= 1;
+        }
+        k >>= 1;
+#endif
+        return k;
+    }  // desce sem desvios; no fim, desfaz as descidas à direita finais
+
+    void* raw_{nullptr};
+    T* data_{nullptr};
+    std::size_t size_{0u};
+};
+
+}  // namespace structures
+
+#endif
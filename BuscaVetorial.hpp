@@ -0,0 +1,264 @@
+#ifndef STRUCTURES_SIMD_SEARCH_H
+#define STRUCTURES_SIMD_SEARCH_H
+
+#include <cstdint>  // std::size_t, std::int32_t, std::int64_t
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define STRUCTURES_SIMD_X86 1
+#include <immintrin.h>  // SSE2, AVX2, AVX-512
+#endif
+
+namespace structures {
+namespace simd {
+
+//! Estrutura Search
+/*! A estrutura Search indica se há busca vetorial para o tipo T. Para os
+ *  tipos aritméticos suportados, find compara vários dados por instrução,
+ *  escolhendo em tempo de execução entre AVX-512, AVX2 e SSE2. */
+
+template<typename T>
+struct Search {
+    static const bool enabled = false;
+};
+
+#ifdef STRUCTURES_SIMD_X86
+
+template<typename T>
+using Kernel = std::size_t (*)(const T*, std::size_t, T);
+
+template<typename T>
+std::size_t find_tail(const T* v, std::size_t i, std::size_t n, T x) {
+    for (; i < n; i++) {
+        if (v[i] == x) {
+            return i;
+        }
+    }
+    return n;
+}  // dados que não completam um vetor
+
+// SSE2: 2 a 4 dados por comparação
+
+__attribute__((target("sse2")))
+inline std::size_t find_sse2(const std::int32_t* v, std::size_t n,
+                             std::int32_t x) {
+    const __m128i key = _mm_set1_epi32(x);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(v+i));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(block,
+                                                                     key)));
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return find_tail(v, i, n, x);
+}
+
+__attribute__((target("sse2")))
+inline std::size_t find_sse2(const std::int64_t* v, std::size_t n,
+                             std::int64_t x) {
+    const __m128i key = _mm_set1_epi64x(x);
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(v+i));
+        __m128i equal = _mm_cmpeq_epi32(block, key);
+        // 64 bits iguais: as duas metades de 32 bits são iguais
+        equal = _mm_and_si128(equal, _mm_shuffle_epi32(equal,
+                                                       _MM_SHUFFLE(2, 3, 0, 1)));
+        int mask = _mm_movemask_pd(_mm_castsi128_pd(equal));
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return find_tail(v, i, n, x);
+}
+
+__attribute__((target("sse2")))
+inline std::size_t find_sse2(const float* v, std::size_t n, float x) {
+    const __m128 key = _mm_set1_ps(x);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        int mask = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(v+i), key));
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return find_tail(v, i, n, x);
+}
+
+__attribute__((target("sse2")))
+inline std::size_t find_sse2(const double* v, std::size_t n, double x) {
+    const __m128d key = _mm_set1_pd(x);
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        int mask = _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(v+i), key));
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return find_tail(v, i, n, x);
+}
+
+// AVX2: 4 a 8 dados por comparação
+
+__attribute__((target("avx2")))
+inline std::size_t find_avx2(const std::int32_t* v, std::size_t n,
+                             std::int32_t x) {
+    const __m256i key = _mm256_set1_epi32(x);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i block = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(v+i));
+        int mask = _mm256_movemask_ps(
+            _mm256_castsi256_ps(_mm256_cmpeq_epi32(block, key)));
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return find_tail(v, i, n, x);
+}
+
+__attribute__((target("avx2")))
+inline std::size_t find_avx2(const std::int64_t* v, std::size_t n,
+                             std::int64_t x) {
+    const __m256i key = _mm256_set1_epi64x(x);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i block = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(v+i));
+        int mask = _mm256_movemask_pd(
+            _mm256_castsi256_pd(_mm256_cmpeq_epi64(block, key)));
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return find_tail(v, i, n, x);
+}
+
+__attribute__((target("avx2")))
+inline std::size_t find_avx2(const float* v, std::size_t n, float x) {
+    const __m256 key = _mm256_set1_ps(x);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        int mask = _mm256_movemask_ps(
+            _mm256_cmp_ps(_mm256_loadu_ps(v+i), key, _CMP_EQ_OQ));
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return find_tail(v, i, n, x);
+}
+
+__attribute__((target("avx2")))
+inline std::size_t find_avx2(const double* v, std::size_t n, double x) {
+    const __m256d key = _mm256_set1_pd(x);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        int mask = _mm256_movemask_pd(
+            _mm256_cmp_pd(_mm256_loadu_pd(v+i), key, _CMP_EQ_OQ));
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return find_tail(v, i, n, x);
+}
+
+// AVX-512: 8 a 16 dados por comparação
+
+__attribute__((target("avx512f")))
+inline std::size_t find_avx512(const std::int32_t* v, std::size_t n,
+                               std::int32_t x) {
+    const __m512i key = _mm512_set1_epi32(x);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __mmask16 mask = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(v+i), key);
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return find_tail(v, i, n, x);
+}
+
+__attribute__((target("avx512f")))
+inline std::size_t find_avx512(const std::int64_t* v, std::size_t n,
+                               std::int64_t x) {
+    const __m512i key = _mm512_set1_epi64(x);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __mmask8 mask = _mm512_cmpeq_epi64_mask(_mm512_loadu_si512(v+i), key);
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return find_tail(v, i, n, x);
+}
+
+__attribute__((target("avx512f")))
+inline std::size_t find_avx512(const float* v, std::size_t n, float x) {
+    const __m512 key = _mm512_set1_ps(x);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __mmask16 mask = _mm512_cmp_ps_mask(_mm512_loadu_ps(v+i), key,
+                                            _CMP_EQ_OQ);
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return find_tail(v, i, n, x);
+}
+
+__attribute__((target("avx512f")))
+inline std::size_t find_avx512(const double* v, std::size_t n, double x) {
+    const __m512d key = _mm512_set1_pd(x);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __mmask8 mask = _mm512_cmp_pd_mask(_mm512_loadu_pd(v+i), key,
+                                           _CMP_EQ_OQ);
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return find_tail(v, i, n, x);
+}
+
+template<typename T>
+Kernel<T> pick(Kernel<T> avx512, Kernel<T> avx2, Kernel<T> sse2) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return avx2;
+    }
+    return sse2;
+}  // melhor conjunto de instruções do processador atual
+
+template<typename T>
+struct VectorSearch {
+    static const bool enabled = true;
+
+    static std::size_t find(const T* v, std::size_t n, T x) {
+        static const Kernel<T> kernel = pick<T>(find_avx512, find_avx2,
+                                                find_sse2);
+        return kernel(v, n, x);
+    }  // a escolha é feita uma única vez
+};
+
+template<>
+struct Search<std::int32_t> : VectorSearch<std::int32_t> {};
+
+template<>
+struct Search<std::int64_t> : VectorSearch<std::int64_t> {};
+
+template<>
+struct Search<float> : VectorSearch<float> {};
+
+template<>
+struct Search<double> : VectorSearch<double> {};
+
+#endif  // STRUCTURES_SIMD_X86
+
+}  // namespace simd
+}  // namespace structures
+
+#endif
@@ -1,8 +1,14 @@
 #ifndef STRUCTURES_ARRAY_QUEUE_H
 #define STRUCTURES_ARRAY_QUEUE_H
 
+#include <atomic>  // std::atomic
+#include <cstddef>  // std::ptrdiff_t
 #include <cstdint>  // std::size_t
+#include <memory>  // std::allocator
+#include <new>  // placement new
 #include <stdexcept>  // C++ Exceptions
+#include <type_traits>  // std::aligned_storage, std::is_nothrow_*
+#include <utility>  // std::move
 
 namespace structures {
 
@@ -13,39 +19,109 @@ template<typename T>
 class ArrayQueue {
  private:
     T* contents;
-    int beg_, end_;
+    std::size_t beg_, end_;  // contadores livres; a posição é wrap(contador)
     std::size_t max_size_;
+    std::size_t mask_;  // max_size_-1 se potência de dois, senão 0
+    bool overwrite_;
     static const auto DEFAULT_SIZE = 10u;
 
+    std::size_t wrap(std::size_t index) const {
+        return (mask_ != 0 ? (index & mask_) : (index % max_size_));
+    }  // posição circular no vetor
+
+    void init(std::size_t max, bool overwrite) {
+        max_size_ = max;
+        contents = std::allocator<T>().allocate(max_size_);
+        beg_ = 0;
+        end_ = 0;
+        mask_ = ((max_size_ > 1 && (max_size_ & (max_size_-1)) == 0)
+                 ? max_size_-1 : 0);
+        overwrite_ = overwrite;
+    }
+
  public:
     ArrayQueue() {
-        max_size_ = DEFAULT_SIZE;
-        contents = new T[max_size_];
-        beg_ = -1;
-        end_ = -1;
+        init(DEFAULT_SIZE, false);
     }
 
     explicit ArrayQueue(std::size_t max) {
         // param o parametro max define o tamanho genérico da fila.
-        max_size_ = max;
-        contents = new T[max_size_];
-        beg_ = -1;
-        end_ = -1;
+        init(max, false);
+    }
+
+    ArrayQueue(std::size_t max, bool overwrite) {
+        // param o parametro overwrite descarta o dado mais antigo se cheia.
+        init(max, overwrite);
+    }
+
+    ArrayQueue(const ArrayQueue& other) {
+        init(other.max_size_, other.overwrite_);
+        for (std::size_t i = other.beg_; i != other.end_; i++) {
+            new (contents + wrap(end_)) T(other.contents[other.wrap(i)]);
+            end_++;
+        }
     }
 
+    ArrayQueue(ArrayQueue&& other) noexcept {
+        contents = other.contents;
+        beg_ = other.beg_;
+        end_ = other.end_;
+        max_size_ = other.max_size_;
+        mask_ = other.mask_;
+        overwrite_ = other.overwrite_;
+        other.contents = nullptr;
+        other.beg_ = 0;
+        other.end_ = 0;
+        other.max_size_ = 0;
+        other.mask_ = 0;
+        other.overwrite_ = false;
+    }  // toma o vetor de other sem copiar os dados
+
+    ArrayQueue& operator=(ArrayQueue other) {
+        std::swap(contents, other.contents);
+        std::swap(beg_, other.beg_);
+        std::swap(end_, other.end_);
+        std::swap(max_size_, other.max_size_);
+        std::swap(mask_, other.mask_);
+        std::swap(overwrite_, other.overwrite_);
+        return *this;
+    }  // cópia ou movimento conforme o argumento
+
     ~ArrayQueue() {
-        delete[] contents;
+        clear();
+        std::allocator<T>().deallocate(contents, max_size_);
     }
 
     //! Método enqueue
     /*! O método enqueue insere dados na fila. */
     void enqueue(const T& data) {
+        emplace(data);
+    }  // insere
+
+    //! Método enqueue
+    /*! O método enqueue move dados para a fila. */
+    void enqueue(T&& data) {
+        emplace(std::move(data));
+    }  // insere sem copiar
+
+    //! Método emplace
+    /*! O método emplace constrói um dado no fim da fila a partir dos
+     *  argumentos. Uma fila de tamanho 0 está sempre cheia, mesmo no modo
+     *  que descarta o dado mais antigo. */
+    template<typename... Args>
+    T& emplace(Args&&... args) {
         if (full()) {
-            throw(std::out_of_range("A fila está cheia."));  // excecao
+            if (!overwrite_ || empty()) {
+                throw(std::out_of_range("A fila está cheia."));  // excecao
+            }
+            contents[wrap(beg_)].~T();  // descarta o mais antigo
+            beg_++;
         }
+        T* slot = contents + wrap(end_);
+        new (slot) T(std::forward<Args>(args)...);  // constrói no lugar
         end_++;
-        contents[end_] = data;
-    }  // insere
+        return *slot;
+    }
 
     //! Método dequeue
     /*! O método dequeue retira dados da fila. */
@@ -53,25 +129,30 @@ class ArrayQueue {
         if (empty()) {
             throw(std::out_of_range("A fila está vazia."));  // excecao
         }
+        T back = std::move(contents[wrap(beg_)]);
+        contents[wrap(beg_)].~T();
         beg_++;
-        return contents[beg_];
+        return back;
     }  // retira
 
     //! Método back
-    /*! O método back retorna o dado primeiro dado da fila. */
+    /*! O método back retorna o último dado da fila. */
     T& back() {
         if (empty()) {
             throw(std::out_of_range("A fila está vazia."));  // excecao
         } else {
-            return contents[end_];
+            return contents[wrap(end_-1)];
         }
     }
 
     //! Método clear
     /*! O método clear limpa a fila. */
     void clear() {
-        beg_ = -1;
-        end_ = -1;
+        for (; beg_ != end_; beg_++) {
+            contents[wrap(beg_)].~T();
+        }
+        beg_ = 0;
+        end_ = 0;
     }  // limpa
 
     //! Método size
@@ -89,20 +170,389 @@ class ArrayQueue {
     //! Método empty
     /*! O método empty verifica se a fila está vazia. */
     bool empty() {
-        if (beg_ == end_) {
-            return true;
-        }
-        return false;
+        return (beg_ == end_);
     }  // vazia
 
     //! Método full
     /*! O método full verifica se fila está cheia. */
     bool full() {
-        if (end_-beg_ == static_cast<int>(max_size_)) {
-            return true;
+        return (end_-beg_ == max_size_);
+    }  // cheia
+};
+
+//! Classe SPSCArrayQueue
+/*! A Classe SPSCArrayQueue é uma fila circular sem travas para exatamente
+ *  uma thread produtora e uma thread consumidora. */
+
+template<typename T>
+class SPSCArrayQueue {
+ public:
+    SPSCArrayQueue() : SPSCArrayQueue(DEFAULT_SIZE) {}
+
+    explicit SPSCArrayQueue(std::size_t max) :
+        contents{std::allocator<T>().allocate(max)},
+        max_size_{max},
+        mask_{(max > 1 && (max & (max-1)) == 0) ? max-1 : 0}
+    {}
+
+    SPSCArrayQueue(const SPSCArrayQueue&) = delete;
+    SPSCArrayQueue& operator=(const SPSCArrayQueue&) = delete;
+
+    ~SPSCArrayQueue() {
+        std::size_t tail = tail_.load(std::memory_order_acquire);
+        for (std::size_t i = head_.load(); i != tail; i++) {
+            contents[wrap(i)].~T();
+        }
+        std::allocator<T>().deallocate(contents, max_size_);
+    }
+
+    //! Método try_enqueue
+    /*! O método try_enqueue insere um dado; retorna false se a fila está
+     *  cheia. Só pode ser chamado pela thread produtora. */
+    bool try_enqueue(const T& data) {
+        return try_emplace(data);
+    }
+
+    //! Método try_enqueue
+    /*! O método try_enqueue move um dado para a fila; retorna false se a
+     *  fila está cheia (data não é alterado).
+     *  Só pode ser chamado pela thread produtora. */
+    bool try_enqueue(T&& data) {
+        return try_emplace(std::move(data));
+    }
+
+    //! Método try_emplace
+    /*! O método try_emplace constrói um dado na fila a partir dos
+     *  argumentos; retorna false se a fila está cheia.
+     *  Só pode ser chamado pela thread produtora. */
+    template<typename... Args>
+    bool try_emplace(Args&&... args) {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ == max_size_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ == max_size_) {
+                return false;
+            }
+        }
+        new (contents + wrap(tail)) T(std::forward<Args>(args)...);
+        tail_.store(tail+1, std::memory_order_release);
+        return true;
+    }
+
+    //! Método try_dequeue
+    /*! O método try_dequeue retira um dado para out; retorna false se a fila
+     *  está vazia. Só pode ser chamado pela thread consumidora. */
+    bool try_dequeue(T& out) {
+        std::size_t head;
+        if (!readable(head)) {
+            return false;
+        }
+        out = std::move(contents[wrap(head)]);
+        contents[wrap(head)].~T();
+        head_.store(head+1, std::memory_order_release);
+        return true;
+    }
+
+    //! Método enqueue
+    /*! O método enqueue insere dados na fila. */
+    void enqueue(const T& data) {
+        if (!try_enqueue(data)) {
+            throw(std::out_of_range("A fila está cheia."));  // excecao
+        }
+    }  // insere
+
+    //! Método enqueue
+    /*! O método enqueue move dados para a fila. */
+    void enqueue(T&& data) {
+        if (!try_enqueue(std::move(data))) {
+            throw(std::out_of_range("A fila está cheia."));  // excecao
+        }
+    }  // insere sem copiar
+
+    //! Método dequeue
+    /*! O método dequeue retira dados da fila. */
+    T dequeue() {
+        std::size_t head;
+        if (!readable(head)) {
+            throw(std::out_of_range("A fila está vazia."));  // excecao
+        }
+        T back(std::move(contents[wrap(head)]));
+        contents[wrap(head)].~T();
+        head_.store(head+1, std::memory_order_release);
+        return back;
+    }  // retira
+
+    //! Método size
+    /*! O método size retorna uma estimativa do total de dados na fila. */
+    std::size_t size() const {
+        std::size_t head = head_.load(std::memory_order_acquire);
+        return tail_.load(std::memory_order_acquire) - head;
+    }
+
+    //! Método max_size
+    /*! O método max_size retorna o tamanho total da fila. */
+    std::size_t max_size() const {
+        return max_size_;
+    }
+
+    //! Método empty
+    /*! O método empty verifica se a fila está vazia. */
+    bool empty() const {
+        return (size() == 0);
+    }  // vazia
+
+    //! Método full
+    /*! O método full verifica se fila está cheia. */
+    bool full() const {
+        return (size() == max_size_);
+    }  // cheia
+
+ private:
+    static const std::size_t CACHE_LINE = 64;
+    static const auto DEFAULT_SIZE = 10u;
+
+    std::size_t wrap(std::size_t index) const {
+        return (mask_ != 0 ? (index & mask_) : (index % max_size_));
+    }  // posição circular no vetor
+
+    bool readable(std::size_t& head) {
+        head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return false;
+            }
+        }
+        return true;
+    }  // posição do primeiro dado, se houver; só a consumidora chama
+
+    // dados somente-leitura, compartilhados pelas duas threads
+    T* const contents;
+    const std::size_t max_size_;
+    const std::size_t mask_;
+
+    // lado consumidor: head_ e a cópia local do tail_ do produtor
+    alignas(CACHE_LINE) std::atomic<std::size_t> head_{0};
+    std::size_t cached_tail_{0};
+
+    // lado produtor: tail_ e a cópia local do head_ do consumidor
+    alignas(CACHE_LINE) std::atomic<std::size_t> tail_{0};
+    std::size_t cached_head_{0};
+};
+
+//! Classe MPMCArrayQueue
+/*! A Classe MPMCArrayQueue é uma fila circular sem travas para várias
+ *  threads produtoras e consumidoras (fila de Vyukov com sequência por
+ *  posição). O tamanho precisa ser ao menos 2. */
+
+template<typename T>
+class MPMCArrayQueue {
+    static_assert(std::is_nothrow_move_constructible<T>::value,
+                  "Uma posição ocupada precisa receber o dado sem exceção.");
+
+ public:
+    MPMCArrayQueue() : MPMCArrayQueue(DEFAULT_SIZE) {}
+
+    explicit MPMCArrayQueue(std::size_t max) :
+        contents{new Cell[valid_size(max)]},
+        max_size_{max},
+        mask_{(max > 1 && (max & (max-1)) == 0) ? max-1 : 0}
+    {
+        for (std::size_t i = 0; i < max_size_; i++) {
+            contents[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MPMCArrayQueue(const MPMCArrayQueue&) = delete;
+    MPMCArrayQueue& operator=(const MPMCArrayQueue&) = delete;
+
+    ~MPMCArrayQueue() {
+        std::size_t end = end_.load(std::memory_order_acquire);
+        for (std::size_t i = beg_.load(); i != end; i++) {
+            contents[wrap(i)].data()->~T();
+        }
+        delete[] contents;
+    }
+
+    //! Método try_enqueue
+    /*! O método try_enqueue insere um dado; retorna false se a fila está
+     *  cheia. */
+    bool try_enqueue(const T& data) {
+        return try_emplace(data);
+    }
+
+    //! Método try_enqueue
+    /*! O método try_enqueue move um dado para a fila; retorna false se a
+     *  fila está cheia (data não é alterado). */
+    bool try_enqueue(T&& data) {
+        return try_emplace(std::move(data));
+    }
+
+    //! Método try_emplace
+    /*! O método try_emplace constrói um dado na fila a partir dos
+     *  argumentos; retorna false se a fila está cheia. Se construir o dado
+     *  pode lançar exceção, ele é construído antes de ocupar uma posição. */
+    template<typename... Args>
+    bool try_emplace(Args&&... args) {
+        return emplace_value(std::is_nothrow_constructible<T, Args&&...>(),
+                             std::forward<Args>(args)...);
+    }
+
+    //! Método try_dequeue
+    /*! O método try_dequeue retira um dado para out; retorna false se a fila
+     *  está vazia. */
+    bool try_dequeue(T& out) {
+        std::size_t pos;
+        Cell *cell = claim_front(pos);
+        if (cell == nullptr) {
+            return false;
+        }
+        T data(take(cell, pos));
+        out = std::move(data);  // a posição já foi liberada
+        return true;
+    }
+
+    //! Método enqueue
+    /*! O método enqueue insere dados na fila. */
+    void enqueue(const T& data) {
+        if (!try_enqueue(data)) {
+            throw(std::out_of_range("A fila está cheia."));  // excecao
+        }
+    }  // insere
+
+    //! Método enqueue
+    /*! O método enqueue move dados para a fila. */
+    void enqueue(T&& data) {
+        if (!try_enqueue(std::move(data))) {
+            throw(std::out_of_range("A fila está cheia."));  // excecao
         }
-        return false;
+    }  // insere sem copiar
+
+    //! Método dequeue
+    /*! O método dequeue retira dados da fila. */
+    T dequeue() {
+        std::size_t pos;
+        Cell *cell = claim_front(pos);
+        if (cell == nullptr) {
+            throw(std::out_of_range("A fila está vazia."));  // excecao
+        }
+        return take(cell, pos);
+    }  // retira
+
+    //! Método size
+    /*! O método size retorna uma estimativa do total de dados na fila. */
+    std::size_t size() const {
+        std::size_t beg = beg_.load(std::memory_order_acquire);
+        std::size_t end = end_.load(std::memory_order_acquire);
+        return (end > beg ? end-beg : 0);
+    }
+
+    //! Método max_size
+    /*! O método max_size retorna o tamanho total da fila. */
+    std::size_t max_size() const {
+        return max_size_;
+    }
+
+    //! Método empty
+    /*! O método empty verifica se a fila está vazia. */
+    bool empty() const {
+        return (size() == 0);
+    }  // vazia
+
+    //! Método full
+    /*! O método full verifica se fila está cheia. */
+    bool full() const {
+        return (size() >= max_size_);
     }  // cheia
+
+ private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+        T* data() {
+            return reinterpret_cast<T*>(&storage);
+        }  // o dado só existe entre enqueue e dequeue
+    };
+
+    static const std::size_t CACHE_LINE = 64;
+    static const auto DEFAULT_SIZE = 10u;
+
+    static std::size_t valid_size(std::size_t max) {
+        if (max < 2) {
+            throw(std::invalid_argument(
+                "A fila precisa de ao menos 2 posições."));
+        }
+        return max;
+    }  // com uma posição, a sequência de uma ocupada parece livre
+
+    std::size_t wrap(std::size_t index) const {
+        return (mask_ != 0 ? (index & mask_) : (index % max_size_));
+    }  // posição circular no vetor
+
+    template<typename... Args>
+    bool emplace_value(std::true_type, Args&&... args) {
+        Cell *cell;
+        std::size_t pos = end_.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &contents[wrap(pos)];
+            std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq - pos);
+            if (diff == 0) {
+                if (end_.compare_exchange_weak(pos, pos+1,
+                                               std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // posição ainda não consumida: cheia
+            } else {
+                pos = end_.load(std::memory_order_relaxed);
+            }
+        }
+        new (cell->data()) T(std::forward<Args>(args)...);
+        cell->sequence.store(pos+1, std::memory_order_release);
+        return true;
+    }  // a construção não lança: a posição ocupada sempre é publicada
+
+    template<typename... Args>
+    bool emplace_value(std::false_type, Args&&... args) {
+        T data(std::forward<Args>(args)...);
+        return emplace_value(std::true_type(), std::move(data));
+    }  // constrói fora da fila e ocupa a posição só para mover
+
+    Cell* claim_front(std::size_t& pos) {
+        Cell *cell;
+        pos = beg_.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &contents[wrap(pos)];
+            std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq - (pos+1));
+            if (diff == 0) {
+                if (beg_.compare_exchange_weak(pos, pos+1,
+                                               std::memory_order_relaxed)) {
+                    return cell;
+                }
+            } else if (diff < 0) {
+                return nullptr;  // posição ainda não escrita: vazia
+            } else {
+                pos = beg_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    T take(Cell* cell, std::size_t pos) {
+        T data(std::move(*cell->data()));
+        cell->data()->~T();
+        cell->sequence.store(pos+max_size_, std::memory_order_release);
+        return data;
+    }  // move o dado para fora e libera a posição para os produtores
+
+    Cell* const contents;
+    const std::size_t max_size_;
+    const std::size_t mask_;
+
+    alignas(CACHE_LINE) std::atomic<std::size_t> end_{0};  // produtores
+    alignas(CACHE_LINE) std::atomic<std::size_t> beg_{0};  // consumidores
 };
 
 }  // namespace structures
@@ -1,50 +1,110 @@
 #ifndef STRUCTURES_LINKED_QUEUE_H
 #define STRUCTURES_LINKED_QUEUE_H
 
+#include <atomic>  // std::atomic
 #include <cstdint>  // std::size_t
+#include <memory>  // std::allocator_traits
+#include <new>  // placement new
 #include <stdexcept>  // C++ exceptions
+#include <type_traits>  // std::aligned_storage
+#include <utility>  // std::move, std::forward, std::swap
+
+#include "./Alocador.hpp"
 
 namespace structures {
 
 //! Classe LinkedQueue
 /*! A Classe LinkedQueue é uma fila de dados encadeada. */
 
-template<typename T>
+template<typename T, typename Alloc = std::allocator<T>>
 class LinkedQueue {
  public:
     LinkedQueue() = default;
 
+    explicit LinkedQueue(const Alloc& alloc):
+        alloc_{alloc}
+    {}  // nodos alocados por alloc
+
+    LinkedQueue(const LinkedQueue& other):
+        alloc_{NodeTraits::select_on_container_copy_construction(other.alloc_)}
+    {
+        for (const Node *n = other.head; n != nullptr; n = n->next()) {
+            enqueue(n->data());
+        }
+    }  // cópia na mesma ordem
+
+    LinkedQueue(LinkedQueue&& other) noexcept:
+        head{other.head},
+        tail{other.tail},
+        size_{other.size_},
+        alloc_{std::move(other.alloc_)}
+    {
+        other.head = nullptr;
+        other.tail = nullptr;
+        other.size_ = 0;
+    }  // toma os nodos de other
+
+    LinkedQueue& operator=(LinkedQueue other) {
+        swap(other);
+        return *this;
+    }  // cópia ou movimento conforme o argumento
+
     ~LinkedQueue() {
         clear();
     }
 
+    //! Método swap
+    /*! O método swap troca o conteúdo de duas filas em O(1). */
+    void swap(LinkedQueue& other) noexcept {
+        std::swap(head, other.head);
+        std::swap(tail, other.tail);
+        std::swap(size_, other.size_);
+        std::swap(alloc_, other.alloc_);
+    }
+
     //! Método clear
     /*! O método clear limpa a fila. */
     void clear() {
-        Node *previous = head;
-        while (previous != nullptr) {
-            previous = previous->next();
-            dequeue();
+        if (!release_arena(alloc_)) {
+            Node *current = head;
+            while (current != nullptr) {
+                Node *previous = current;
+                current = current->next();
+                dispose(previous);
+            }
         }
         head = nullptr;
         tail = nullptr;
         size_ = 0;
-    }  // limpar
+    }  // limpar; com arena, todos os nodos de uma vez
 
     //! Método enqueue
     /*! O método enqueue insere dados na fila. */
     void enqueue(const T& data) {
+        emplace(data);
+    }  // enfilerar
+
+    //! Método enqueue
+    /*! O método enqueue move dados para a fila. */
+    void enqueue(T&& data) {
+        emplace(std::move(data));
+    }  // enfilerar sem copiar
+
+    //! Método emplace
+    /*! O método emplace constrói um dado no fim da fila a partir dos
+     *  argumentos. */
+    template<typename... Args>
+    T& emplace(Args&&... args) {
+        Node *n = create(nullptr, std::forward<Args>(args)...);
         if (empty()) {
-            head = new Node(data, nullptr);
-            tail = head;
+            head = n;
         } else {
-            tail->next(new Node(data, nullptr));
-            tail = tail->next();
+            tail->next(n);
         }
-        // n->next(nullptr);
-        // tail = new Node(data, nullptr);
+        tail = n;
         size_++;
-    }  // enfilerar
+        return n->data();
+    }  // constrói no lugar
 
     //! Método dequeue
     /*! O método dequeue retira dados da fila. */
@@ -53,9 +113,9 @@ class LinkedQueue {
             throw(std::out_of_range("A fila está vazia."));
         }
         Node *n = head;
-        T back = n->data();
+        T back = std::move(n->data());
         head = head->next();
-        delete n;
+        dispose(n);
         size_--;
         return back;
     }  // desenfilerar
@@ -93,14 +153,11 @@ class LinkedQueue {
  private:
     class Node {
      public:
-        explicit Node(const T& data) {
-            data_ = data;
-        }
-
-        Node(const T& data, Node* next) {
-            data_ = data;
-            next_ = next;
-        }
+        template<typename... Args>
+        explicit Node(Node* next, Args&&... args):
+            data_(std::forward<Args>(args)...),
+            next_{next}
+        {}  // dado construído no próprio nodo
 
         T& data() {
             return data_;
@@ -127,9 +184,301 @@ class LinkedQueue {
         Node* next_;
     };
 
+    using NodeAlloc =
+        typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAlloc>;
+
+    template<typename... Args>
+    Node* create(Args&&... args) {
+        Node *n = NodeTraits::allocate(alloc_, 1);
+        try {
+            NodeTraits::construct(alloc_, n, std::forward<Args>(args)...);
+        } catch (...) {
+            NodeTraits::deallocate(alloc_, n, 1);
+            throw;
+        }
+        return n;
+    }  // nodo construído na memória do alocador
+
+    void dispose(Node* n) {
+        NodeTraits::destroy(alloc_, n);
+        NodeTraits::deallocate(alloc_, n, 1);
+    }
+
     Node* head{nullptr};  // nodo-cabeça
     Node* tail{nullptr};  // nodo-fim
     std::size_t size_{0u};  // tamanho
+    NodeAlloc alloc_;
+};
+
+//! Classe ConcurrentLinkedQueue
+/*! A Classe ConcurrentLinkedQueue é uma fila encadeada sem travas para
+ *  várias threads (algoritmo de Michael e Scott). Os nodos retirados são
+ *  liberados com hazard pointers, então dequeue nunca lê um nodo apagado. */
+
+template<typename T>
+class ConcurrentLinkedQueue {
+ public:
+    ConcurrentLinkedQueue() {
+        Node *dummy = new Node();
+        head.store(dummy, std::memory_order_relaxed);
+        tail.store(dummy, std::memory_order_relaxed);
+    }
+
+    ConcurrentLinkedQueue(const ConcurrentLinkedQueue&) = delete;
+    ConcurrentLinkedQueue& operator=(const ConcurrentLinkedQueue&) = delete;
+
+    ~ConcurrentLinkedQueue() {
+        Node *current = head.load(std::memory_order_relaxed);
+        Node *next = current->next.load(std::memory_order_relaxed);
+        delete current;  // o nodo-cabeça não tem dado
+        while (next != nullptr) {
+            current = next;
+            next = current->next.load(std::memory_order_relaxed);
+            current->data()->~T();
+            delete current;
+        }
+        HazardRecord *record = records.load(std::memory_order_relaxed);
+        while (record != nullptr) {
+            HazardRecord *previous = record;
+            record = record->next;
+            Node *retired = previous->retired;
+            while (retired != nullptr) {
+                Node *out = retired;
+                retired = retired->retired_next;
+                delete out;
+            }
+            delete previous;
+        }
+    }
+
+    //! Método enqueue
+    /*! O método enqueue insere dados na fila. */
+    void enqueue(const T& data) {
+        emplace(data);
+    }  // enfilerar
+
+    //! Método enqueue
+    /*! O método enqueue move dados para a fila. */
+    void enqueue(T&& data) {
+        emplace(std::move(data));
+    }  // enfilerar sem copiar
+
+    //! Método emplace
+    /*! O método emplace constrói um dado no fim da fila a partir dos
+     *  argumentos; o nodo é criado antes de disputar a cauda. */
+    template<typename... Args>
+    void emplace(Args&&... args) {
+        Node *n = new Node();
+        try {
+            new (n->data()) T(std::forward<Args>(args)...);
+        } catch (...) {
+            delete n;
+            throw;
+        }
+        HazardRecord *record = acquire();
+        for (;;) {
+            Node *last = protect(record, 0, tail);
+            Node *next = last->next.load(std::memory_order_acquire);
+            if (last != tail.load(std::memory_order_acquire)) {
+                continue;
+            }
+            if (next == nullptr) {
+                if (last->next.compare_exchange_weak(next, n)) {
+                    tail.compare_exchange_strong(last, n);
+                    break;
+                }
+            } else {
+                tail.compare_exchange_strong(last, next);  // ajuda o atrasado
+            }
+        }
+        release(record);
+        size_.fetch_add(1, std::memory_order_relaxed);
+    }  // constrói e publica
+
+    //! Método try_dequeue
+    /*! O método try_dequeue retira um dado para out; retorna false se a fila
+     *  está vazia. */
+    bool try_dequeue(T& out) {
+        HazardRecord *record = acquire();
+        Node *next;
+        Node *first = unlink_first(record, next);
+        if (first == nullptr) {
+            release(record);
+            return false;
+        }
+        out = take(record, first, next);
+        return true;
+    }
+
+    //! Método dequeue
+    /*! O método dequeue retira dados da fila. */
+    T dequeue() {
+        HazardRecord *record = acquire();
+        Node *next;
+        Node *first = unlink_first(record, next);
+        if (first == nullptr) {
+            release(record);
+            throw(std::out_of_range("A fila está vazia."));
+        }
+        return take(record, first, next);
+    }  // desenfilerar
+
+    //! Método empty
+    /*! O método empty verifica se a fila está vazia. */
+    bool empty() const {
+        return (size() == 0);
+    }  // fila vazia
+
+    //! Método size
+    /*! O método size retorna uma estimativa do tamanho da fila. */
+    std::size_t size() const {
+        long size = size_.load(std::memory_order_relaxed);
+        return (size > 0 ? size : 0);
+    }  // tamanho
+
+ private:
+    struct Node {
+        T* data() {
+            return reinterpret_cast<T*>(&storage);
+        }  // o dado existe em todo nodo, menos no nodo-cabeça
+
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+        std::atomic<Node*> next{nullptr};
+        Node* retired_next{nullptr};  // lista de nodos aguardando liberação
+    };
+
+    struct HazardRecord {
+        std::atomic<Node*> hazard[2];
+        std::atomic<bool> active{true};
+        HazardRecord* next{nullptr};
+        Node* retired{nullptr};  // só acessado por quem detém o registro
+        std::size_t retired_count{0u};
+    };
+
+    static const std::size_t RETIRE_THRESHOLD = 64u;
+
+    Node* unlink_first(HazardRecord* record, Node*& next) {
+        for (;;) {
+            Node *first = protect(record, 0, head);
+            Node *last = tail.load(std::memory_order_acquire);
+            next = first->next.load(std::memory_order_acquire);
+            record->hazard[1].store(next);
+            if (first != head.load()) {
+                continue;
+            }
+            if (next == nullptr) {
+                return nullptr;
+            }
+            if (first == last) {
+                tail.compare_exchange_strong(last, next);  // ajuda o atrasado
+                continue;
+            }
+            if (head.compare_exchange_strong(first, next)) {
+                return first;
+            }
+        }
+    }  // avança o nodo-cabeça; next, ainda protegido, guarda o dado
+
+    T take(HazardRecord* record, Node* first, Node* next) {
+        try {
+            T back(std::move(*next->data()));
+            finish(record, first, next);
+            return back;
+        } catch (...) {
+            finish(record, first, next);
+            throw;
+        }
+    }  // move o dado para fora do novo nodo-cabeça
+
+    void finish(HazardRecord* record, Node* first, Node* next) {
+        next->data()->~T();  // next vira o nodo-cabeça, sem dado
+        record->hazard[0].store(nullptr);
+        record->hazard[1].store(nullptr);
+        retire(record, first);
+        release(record);
+        size_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    HazardRecord* acquire() {
+        HazardRecord *record = records.load(std::memory_order_acquire);
+        for (; record != nullptr; record = record->next) {
+            bool idle = false;
+            if (!record->active.load(std::memory_order_relaxed) &&
+                record->active.compare_exchange_strong(idle, true)) {
+                return record;
+            }
+        }
+        record = new HazardRecord();
+        record->hazard[0].store(nullptr, std::memory_order_relaxed);
+        record->hazard[1].store(nullptr, std::memory_order_relaxed);
+        HazardRecord *first = records.load(std::memory_order_relaxed);
+        do {
+            record->next = first;
+        } while (!records.compare_exchange_weak(first, record));
+        return record;
+    }  // obtém um registro de hazard pointers livre (ou cria um)
+
+    void release(HazardRecord* record) {
+        record->hazard[0].store(nullptr);
+        record->hazard[1].store(nullptr);
+        record->active.store(false, std::memory_order_release);
+    }
+
+    Node* protect(HazardRecord* record, int i, std::atomic<Node*>& source) {
+        Node *n = source.load();
+        for (;;) {
+            record->hazard[i].store(n);
+            Node *check = source.load();
+            if (check == n) {
+                return n;
+            }
+            n = check;
+        }
+    }  // publica o nodo lido e confirma que ainda está ligado
+
+    void retire(HazardRecord* record, Node* n) {
+        n->retired_next = record->retired;
+        record->retired = n;
+        if (++record->retired_count >= RETIRE_THRESHOLD) {
+            scan(record);
+        }
+    }  // chamado com o registro ainda ativo
+
+    void scan(HazardRecord* owner) {
+        Node *keep = nullptr;
+        std::size_t kept = 0u;
+        Node *retired = owner->retired;
+        while (retired != nullptr) {
+            Node *n = retired;
+            retired = retired->retired_next;
+            if (hazardous(n)) {
+                n->retired_next = keep;
+                keep = n;
+                kept++;
+            } else {
+                delete n;
+            }
+        }
+        owner->retired = keep;
+        owner->retired_count = kept;
+    }  // libera os nodos que nenhuma thread está lendo
+
+    bool hazardous(Node* n) const {
+        HazardRecord *record = records.load(std::memory_order_acquire);
+        for (; record != nullptr; record = record->next) {
+            if (record->hazard[0].load() == n ||
+                record->hazard[1].load() == n) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    alignas(64) std::atomic<Node*> head;  // nodo-cabeça (sentinela)
+    alignas(64) std::atomic<Node*> tail;  // nodo-fim
+    alignas(64) std::atomic<long> size_{0};  // tamanho
+    std::atomic<HazardRecord*> records{nullptr};
 };
 
 }  // namespace structures
@@ -1,99 +1,267 @@
 #ifndef STRUCTURES_ARRAY_LIST_H
 #define STRUCTURES_ARRAY_LIST_H
 
+#include <algorithm>  // std::move, std::move_backward
 #include <cstdint>  // std::size_t
+#include <cstring>  // std::memcpy, std::memmove
+#include <memory>  // std::allocator
+#include <new>  // placement new
 #include <stdexcept>  // C++ exceptions
+#include <type_traits>  // std::is_trivially_copyable
+#include <utility>  // std::move, std::pair
+
+#include "./BuscaVetorial.hpp"
 
 namespace structures {
 
-//! Classe ArrayList
-/*! A classe ArrayList implementa uma lista de dados genérica. */
+//! Estrutura InlineBuffer
+/*! A estrutura InlineBuffer reserva, dentro do próprio objeto, espaço não
+ *  inicializado para N dados. Com N = 0 ela é vazia e não ocupa memória. */
+
+template<typename T, std::size_t N>
+struct InlineBuffer {
+    T* inline_data() {
+        return reinterpret_cast<T*>(storage);
+    }
+
+    const T* inline_data() const {
+        return reinterpret_cast<const T*>(storage);
+    }
+
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage[N];
+};
 
 template<typename T>
-class ArrayList {
+struct InlineBuffer<T, 0> {
+    T* inline_data() {
+        return nullptr;
+    }
+
+    const T* inline_data() const {
+        return nullptr;
+    }
+};
+
+//! Classe ArrayList
+/*! A classe ArrayList implementa uma lista de dados genérica. Com N > 0,
+ *  os primeiros N dados ficam dentro do próprio objeto e o vetor só vai
+ *  para o heap quando a lista passa desse tamanho: listas pequenas não
+ *  alocam memória. ArrayList<T> (N = 0) mantém o comportamento original. */
+
+template<typename T, std::size_t N = 0>
+class ArrayList : private InlineBuffer<T, N> {
  public:
     ArrayList() {
-        max_size_ = DEFAULT_MAX;
-        contents = new T[max_size_];
+        // com N > 0, começa no buffer interno e cresce para o heap
+        max_size_ = (N > 0 ? N : DEFAULT_MAX);
+        contents = allocate(max_size_);
         size_ = 0;
+        growth_factor_ = (N > 0 ? 2.0 : 0.0);
     }
 
     explicit ArrayList(std::size_t max_size) {
         // param O parametro max_size define o tamanho genérico da lista.
         max_size_ = max_size;
-        contents = new T[max_size_];
+        contents = allocate(max_size_);
+        size_ = 0;
+    }
+
+    ArrayList(std::size_t max_size, double growth_factor) {
+        // param O parametro growth_factor (> 1) ativa o crescimento da lista.
+        max_size_ = max_size;
+        contents = allocate(max_size_);
         size_ = 0;
+        growth_factor_ = growth_factor;
     }
 
+    ArrayList(const ArrayList& other) {
+        max_size_ = other.max_size_;
+        contents = allocate(max_size_);
+        size_ = 0;
+        growth_factor_ = other.growth_factor_;
+        try {
+            for (; size_ < other.size_; size_++) {
+                new (contents + size_) T(other.contents[size_]);
+            }
+        } catch (...) {
+            clear();
+            deallocate(contents, max_size_);
+            throw;
+        }
+    }
+
+    ArrayList(ArrayList&& other) noexcept(NOTHROW_TAKE) {
+        take(other);
+    }  // toma o vetor de other sem copiar os dados
+
+    ArrayList& operator=(ArrayList other) {
+        clear();
+        deallocate(contents, max_size_);
+        take(other);
+        return *this;
+    }  // cópia ou movimento conforme o argumento
+
     ~ArrayList() {
-        delete[] contents;
+        clear();
+        deallocate(contents, max_size_);
+    }
+
+    //! Método swap
+    /*! O método swap troca o conteúdo de duas listas; é O(1) se nenhuma
+     *  delas está no buffer interno. */
+    void swap(ArrayList& other) noexcept(NOTHROW_TAKE) {
+        if (is_inline() || other.is_inline()) {
+            ArrayList tmp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(tmp);
+            return;
+        }
+        std::swap(contents, other.contents);
+        std::swap(size_, other.size_);
+        std::swap(max_size_, other.max_size_);
+        std::swap(growth_factor_, other.growth_factor_);
     }
 
     //! Método clear
     /*! O método clear elimina os dados da lista. */
     void clear() {
+        destroy(0, size_);
         size_ = 0;
     }
 
     //! Método push_back
     /*! O método push_back insere dados na ultima posição da lista. */
     void push_back(const T& data) {
+        emplace_back(data);
+    }
+
+    //! Método push_back
+    /*! O método push_back move dados para a ultima posição da lista. */
+    void push_back(T&& data) {
+        emplace_back(std::move(data));
+    }
+
+    //! Método emplace_back
+    /*! O método emplace_back constrói um dado na ultima posição da lista a
+     *  partir dos argumentos, sem cópias. */
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
         if (full()) {
-            throw(std::out_of_range("A lista está cheia."));
+            grow_emplace(size_, std::forward<Args>(args)...);
         } else {
-            contents[size_++] = data;
+            new (contents + size_) T(std::forward<Args>(args)...);
         }
+        return contents[size_++];
     }
 
     //! Método push_front
     /*! O método push_front insere dados na primeira posição da lista. */
     void push_front(const T& data) {
-        if (full()) {
-            throw(std::out_of_range("A lista está cheia."));
-        } else if (empty()) {
-            contents[size_++] = data;
-        } else {
-            for (int i = size_; i >= 1; i--) {
-                contents[i] = contents[i-1];
-            }
-            contents[0] = data;
-            size_++;
-        }
+        emplace(0, data);
+    }
+
+    //! Método push_front
+    /*! O método push_front move dados para a primeira posição da lista. */
+    void push_front(T&& data) {
+        emplace(0, std::move(data));
+    }
+
+    //! Método emplace_front
+    /*! O método emplace_front constrói um dado na primeira posição da lista
+     *  a partir dos argumentos. */
+    template<typename... Args>
+    T& emplace_front(Args&&... args) {
+        return emplace(0, std::forward<Args>(args)...);
     }
 
     //! Método insert
     /*! O método insert adiciona um dado em uma determinada posição da lista. */
     void insert(const T& data, std::size_t index) {
-        if (full()) {
-            throw(std::out_of_range("A lista está cheia."));
-        } else if ((index > max_size_-1) || (index < 0)) {
+        emplace(index, data);
+    }
+
+    //! Método insert
+    /*! O método insert move um dado para uma determinada posição. */
+    void insert(T&& data, std::size_t index) {
+        emplace(index, std::move(data));
+    }
+
+    //! Método emplace
+    /*! O método emplace constrói um dado em uma determinada posição da lista
+     *  a partir dos argumentos. Só quando é preciso deslocar dados dentro
+     *  do mesmo vetor o dado é construído antes, pois os argumentos podem
+     *  referenciar elementos da própria lista. */
+    template<typename... Args>
+    T& emplace(std::size_t index, Args&&... args) {
+        if (index > size_) {
             // excecao
             throw(std::out_of_range("A posição não existe na lista."));
+        }
+        if (full()) {
+            grow_emplace(index, std::forward<Args>(args)...);
+        } else if (index == size_) {
+            new (contents + index) T(std::forward<Args>(args)...);
         } else {
-            int atl = size_;
-            while (atl != index) {
-                contents[atl] = contents[atl-1];
-                atl--;
-            }
-            contents[index] = data;
-            size_++;
+            T value(std::forward<Args>(args)...);  // args podem estar no vetor
+            open_gap(index);
+            new (contents + index) T(std::move(value));
         }
+        size_++;
+        return contents[index];
     }
 
     //! Método insert_sorted
     /*! O método insert_sorted insere um dado conforme uma especificação. */
     void insert_sorted(const T& data) {
-        if (full()) {
-            throw(std::out_of_range("A lista está cheia."));
-        } else if (empty()) {
-            contents[size_++] = data;
-        } else {
-            int atl = 0;
-            while ((atl != size_) && (data > contents[atl])) {
-                atl++;
-            }
-            insert(data, atl);
+        emplace(lower_bound(data), data);
+    }
+
+    //! Método insert_sorted
+    /*! O método insert_sorted move um dado para a posição ordenada. */
+    void insert_sorted(T&& data) {
+        std::size_t index = lower_bound(data);
+        emplace(index, std::move(data));
+    }
+
+    //! Método lower_bound
+    /*! O método lower_bound retorna a primeira posição de uma lista ordenada
+     *  cujo dado não é menor que data (busca binária sem desvios). */
+    std::size_t lower_bound(const T& data) const {
+        if (empty()) {
+            return 0;
+        }
+        const T* base = contents;
+        std::size_t length = size_;
+        while (length > 1) {
+            std::size_t half = length / 2;
+            base = (base[half] < data) ? base + half : base;
+            length -= half;
         }
+        return (base - contents) + (*base < data);
+    }
+
+    //! Método upper_bound
+    /*! O método upper_bound retorna a primeira posição de uma lista ordenada
+     *  cujo dado é maior que data. */
+    std::size_t upper_bound(const T& data) const {
+        if (empty()) {
+            return 0;
+        }
+        const T* base = contents;
+        std::size_t length = size_;
+        while (length > 1) {
+            std::size_t half = length / 2;
+            base = (data < base[half]) ? base : base + half;
+            length -= half;
+        }
+        return (base - contents) + !(data < *base);
+    }
+
+    //! Método equal_range
+    /*! O método equal_range retorna o intervalo [first, second) de posições
+     *  de uma lista ordenada cujos dados são equivalentes a data. */
+    std::pair<std::size_t, std::size_t> equal_range(const T& data) const {
+        return std::make_pair(lower_bound(data), upper_bound(data));
     }
 
     //! Método pop
@@ -104,11 +272,8 @@ class ArrayList {
         } else if ((index < 0) || index >= size_) {
             throw(std::out_of_range("O índice é inválido."));
         }
-        T val = contents[index];
-        for (int i = index; i != size_-1; i++) {
-            contents[i] = contents[i+1];
-        }
-        size_--;
+        T val = std::move(contents[index]);
+        close_gap(index, index+1);
         return val;
     }
 
@@ -118,8 +283,10 @@ class ArrayList {
         if (empty()) {
             throw(std::out_of_range("A lista está vazia."));
         }
+        T val = std::move(contents[size_-1]);
+        destroy(size_-1, size_);
         size_--;
-        return contents[size_];
+        return val;
     }
 
     //! Método pop_front
@@ -128,11 +295,8 @@ class ArrayList {
         if (empty()) {
             throw(std::out_of_range("A lista está vazia."));
         }
-        T val = contents[0];
-        for (int i = 0; i < size_-1; i++) {
-            contents[i] = contents[i+1];
-        }
-        size_--;
+        T val = std::move(contents[0]);
+        close_gap(0, 1);
         return val;
     }
 
@@ -141,13 +305,79 @@ class ArrayList {
     void remove(const T& data) {
         if (empty()) {
             throw(std::out_of_range("A lista está vazia."));
-        } else {
-            for (int i = 0; i < size_; i++) {
-                if (contents[i] == data) {
-                    pop(i);
+        }
+        remove_all(data);
+    }
+
+    //! Método remove_if
+    /*! O método remove_if exclui, numa única passada estável, os dados que
+     *  satisfazem pred e retorna quantos foram excluídos. */
+    template<typename Predicate>
+    std::size_t remove_if(Predicate pred) {
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < size_; i++) {
+            if (!pred(contents[i])) {
+                if (kept != i) {
+                    contents[kept] = std::move(contents[i]);
                 }
+                kept++;
             }
         }
+        std::size_t removed = size_ - kept;
+        destroy(kept, size_);
+        size_ = kept;
+        return removed;
+    }
+
+    //! Método remove_all
+    /*! O método remove_all exclui todas as ocorrências de data e retorna
+     *  quantas foram excluídas. */
+    std::size_t remove_all(const T& data) {
+        return remove_if([&data](const T& element) {
+            return element == data;
+        });
+    }
+
+    //! Método erase
+    /*! O método erase exclui os dados das posições [first, last) e retorna
+     *  quantos foram excluídos. */
+    std::size_t erase(std::size_t first, std::size_t last) {
+        if ((first > last) || (last > size_)) {
+            throw(std::out_of_range("O intervalo é inválido."));
+        }
+        if (first == last) {
+            return 0;
+        }  // close_gap moveria cada dado sobre si mesmo
+        close_gap(first, last);
+        return last-first;
+    }
+
+    //! Método reserve
+    /*! O método reserve garante espaço para ao menos capacity dados. */
+    void reserve(std::size_t capacity) {
+        if (capacity > max_size_) {
+            reallocate(capacity);
+        }
+    }
+
+    //! Método shrink_to_fit
+    /*! O método shrink_to_fit reduz o tamanho total ao número de dados. */
+    void shrink_to_fit() {
+        if (size_ < max_size_) {
+            reallocate(size_);
+        }
+    }
+
+    //! Método growth_factor
+    /*! O método growth_factor define o fator de crescimento (<= 1 é fixo). */
+    void growth_factor(double factor) {
+        growth_factor_ = factor;
+    }
+
+    //! Método growth_factor
+    /*! O método growth_factor retorna o fator de crescimento da lista. */
+    double growth_factor() const {
+        return growth_factor_;
     }
 
     //! Método full
@@ -165,23 +395,14 @@ class ArrayList {
     //! Método contains
     /*! O método contains verifica se um elemento está contido na lista. */
     bool contains(const T& data) const {
-        for (int i = 0; i < size_; i++) {
-            if (data == contents[i]) {
-                return true;
-            }
-        }
-        return false;
+        return find(data) != size_;
     }
 
     //! Método find
     /*! O método find retorna a posição do dado na lista. */
     std::size_t find(const T& data) const {
-        for (int i = 0; i < size_; i++) {
-            if (data == contents[i]) {
-                return i;
-            }
-        }
-        return size_;
+        return find(data, std::integral_constant<bool,
+                                                 simd::Search<T>::enabled>());
     }
 
     //! Método size
@@ -227,10 +448,150 @@ class ArrayList {
     }
 
  private:
+    std::size_t grown_capacity() const {
+        if (max_size_ == 0) {
+            return (N > 0 ? N : DEFAULT_MAX);
+        }  // lista movida: recebe um vetor novo, qualquer que seja o fator
+        if (growth_factor_ <= 1.0) {
+            throw(std::out_of_range("A lista está cheia."));
+        }
+        std::size_t capacity = max_size_ * growth_factor_;
+        return (capacity > max_size_ ? capacity : max_size_+1);
+    }  // crescimento geométrico: push_back em O(1) amortizado
+
+    template<typename... Args>
+    void grow_emplace(std::size_t index, Args&&... args) {
+        std::size_t capacity = grown_capacity();
+        T* fresh = allocate(capacity);
+        if (fresh == contents) {
+            T value(std::forward<Args>(args)...);  // args podem estar no vetor
+            for (std::size_t i = size_; i > index; i--) {
+                new (contents + i) T(std::move(contents[i-1]));
+                contents[i-1].~T();
+            }
+            new (contents + index) T(std::move(value));
+        } else {
+            try {
+                new (fresh + index) T(std::forward<Args>(args)...);
+            } catch (...) {
+                deallocate(fresh, capacity);
+                throw;
+            }
+            relocate(contents, index, fresh);
+            relocate(contents + index, size_-index, fresh + index + 1);
+            deallocate(contents, max_size_);
+            contents = fresh;
+        }
+        max_size_ = capacity;
+    }  // constrói o dado no vetor novo antes de mover os antigos para ele
+
+    void reallocate(std::size_t capacity) {
+        T* fresh = allocate(capacity);
+        if (fresh != contents) {
+            relocate(contents, size_, fresh);
+            deallocate(contents, max_size_);
+            contents = fresh;
+        }
+        max_size_ = capacity;
+    }  // move os dados para um novo vetor (ou continua no buffer interno)
+
+    void take(ArrayList& other) {
+        growth_factor_ = other.growth_factor_;
+        size_ = other.size_;
+        max_size_ = other.max_size_;
+        if (other.is_inline()) {
+            contents = this->inline_data();
+            relocate(other.contents, other.size_, contents);
+        } else {
+            contents = other.contents;
+            other.contents = other.inline_data();
+            other.max_size_ = 0;
+        }
+        other.size_ = 0;
+    }  // *this não pode ter dados nem vetor alocado
+
+    static void relocate(T* from, std::size_t count, T* to) {
+        if (count == 0) {
+            return;
+        }
+        if (std::is_trivially_copyable<T>::value) {
+            std::memcpy(static_cast<void*>(to), from, count*sizeof(T));
+        } else {
+            for (std::size_t i = 0; i < count; i++) {
+                new (to + i) T(std::move(from[i]));
+                from[i].~T();
+            }
+        }
+    }  // move count dados para memória não inicializada
+
+    bool is_inline() const {
+        return N > 0 && contents == this->inline_data();  // N = 0: sem buffer
+    }
+
+    T* allocate(std::size_t capacity) {
+        if (capacity <= N) {
+            return this->inline_data();
+        }
+        return std::allocator<T>().allocate(capacity);
+    }  // memória bruta e alinhada: nenhum construtor é chamado
+
+    void deallocate(T* buffer, std::size_t capacity) {
+        if (buffer != this->inline_data()) {
+            std::allocator<T>().deallocate(buffer, capacity);
+        }
+    }  // o buffer interno não é liberado
+
+    void destroy(std::size_t first, std::size_t last) {
+        if (!std::is_trivially_destructible<T>::value) {
+            for (std::size_t i = first; i < last; i++) {
+                contents[i].~T();
+            }
+        }
+    }
+
+    std::size_t find(const T& data, std::true_type) const {
+        return simd::Search<T>::find(contents, size_, data);
+    }  // busca vetorial para int32_t, int64_t, float e double
+
+    std::size_t find(const T& data, std::false_type) const {
+        for (std::size_t i = 0; i < size_; i++) {
+            if (data == contents[i]) {
+                return i;
+            }
+        }
+        return size_;
+    }
+
+    void open_gap(std::size_t index) {
+        if (std::is_trivially_copyable<T>::value) {
+            std::memmove(static_cast<void*>(contents+index+1), contents+index,
+                         (size_-index)*sizeof(T));
+        } else if (index < size_) {
+            new (contents + size_) T(std::move(contents[size_-1]));
+            std::move_backward(contents+index, contents+size_-1,
+                               contents+size_);
+            destroy(index, index+1);
+        }
+    }  // desloca [index, size_) uma posição e deixa index sem objeto
+
+    void close_gap(std::size_t first, std::size_t last) {
+        if (std::is_trivially_copyable<T>::value) {
+            std::memmove(static_cast<void*>(contents+first), contents+last,
+                         (size_-last)*sizeof(T));
+        } else {
+            std::move(contents+last, contents+size_, contents+first);
+            destroy(size_-(last-first), size_);
+        }
+        size_ -= last-first;
+    }  // exclui [first, last) puxando o restante para trás
+
     T* contents;
     std::size_t size_;
     std::size_t max_size_;
+    double growth_factor_{0.0};
     static const auto DEFAULT_MAX = 10u;
+    static const bool NOTHROW_TAKE =
+        (N == 0) || std::is_nothrow_move_constructible<T>::value;
 };
 
 }  // namespace structures
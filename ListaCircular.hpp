@@ -1,111 +1,180 @@
 #ifndef STRUCTURES_CIRCULAR_LIST_H
 #define STRUCTURES_CIRCULAR_LIST_H
 
+#include <cstddef>  // std::ptrdiff_t
 #include <cstdint>  // std::size_t
+#include <iterator>  // std::forward_iterator_tag
+#include <memory>  // std::allocator_traits
 #include <stdexcept>  // C++ exceptions
+#include <type_traits>  // std::enable_if, std::is_same
+#include <utility>  // std::move, std::forward, std::swap
+
+#include "./Alocador.hpp"
 
 namespace structures {
 
 //! Classe CircularList
 /*! A classe CircularList implementa uma lista circular genérica. */
 
-template<typename T>
+template<typename T, typename Alloc = std::allocator<T>>
 class CircularList {
+    class Node;
+    template<typename V> class Iterator;
+
  public:
+    using iterator = Iterator<T>;
+    using const_iterator = Iterator<const T>;
+
     CircularList() = default;
 
+    explicit CircularList(const Alloc& alloc):
+        alloc_{alloc}
+    {}  // nodos alocados por alloc
+
+    CircularList(const CircularList& other):
+        alloc_{NodeTraits::select_on_container_copy_construction(other.alloc_)}
+    {
+        for (const T& data : other) {
+            push_back(data);
+        }
+    }  // cópia na mesma ordem
+
+    CircularList(CircularList&& other) noexcept:
+        tail{other.tail},
+        size_{other.size_},
+        alloc_{std::move(other.alloc_)}
+    {
+        other.tail = nullptr;
+        other.size_ = 0;
+    }  // toma os nodos de other
+
+    CircularList& operator=(CircularList other) {
+        swap(other);
+        return *this;
+    }  // cópia ou movimento conforme o argumento
+
     ~CircularList() {
         clear();
     }
 
+    //! Método swap
+    /*! O método swap troca o conteúdo de duas listas em O(1). */
+    void swap(CircularList& other) noexcept {
+        std::swap(tail, other.tail);
+        std::swap(size_, other.size_);
+        std::swap(alloc_, other.alloc_);
+    }
+
     //! Método clear
     /*! O método clear apaga os dados da lista. */
     void clear() {
-        head = nullptr;
+        if (!release_arena(alloc_)) {
+            for (std::size_t i = 0; i < size_; i++) {
+                Node *out = tail->next();
+                tail->next(out->next());
+                dispose(out);
+            }
+        }
+        tail = nullptr;
         size_ = 0;
-    }  // limpar lista
+    }  // limpar lista; com arena, todos os nodos de uma vez
 
     //! Método push_back
     /*! O método push_back insere dados no fim da lista. */
     void push_back(const T& data) {
-        if (empty()) {
-            push_front(data);
-        } else {
-            Node *n = new Node(data, head);
-            Node *last = head;
-            for (int i = 0; i < size_-1; i++) {
-                last = last->next();
-            }
-            last->next(n);
-            size_++;
-        }
-    }  // inserir no fim
+        emplace_back(data);
+    }  // inserir no fim em O(1)
+
+    //! Método push_back
+    /*! O método push_back move dados para o fim da lista. */
+    void push_back(T&& data) {
+        emplace_back(std::move(data));
+    }
+
+    //! Método emplace_back
+    /*! O método emplace_back constrói um dado no fim da lista a partir dos
+     *  argumentos. */
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        emplace_front(std::forward<Args>(args)...);
+        tail = tail->next();
+        return tail->data();
+    }
 
     //! Método push_front
     /*! O método push_front insere dados no começo da lista. */
     void push_front(const T& data) {
+        emplace_front(data);
+    }  // inserir no início em O(1)
+
+    //! Método push_front
+    /*! O método push_front move dados para o começo da lista. */
+    void push_front(T&& data) {
+        emplace_front(std::move(data));
+    }
+
+    //! Método emplace_front
+    /*! O método emplace_front constrói um dado no começo da lista a partir
+     *  dos argumentos. */
+    template<typename... Args>
+    T& emplace_front(Args&&... args) {
         if (empty()) {
-            head = new Node{data};
-            head->next(head);
-        } else {
-            Node *last = head;
-            for (int i = 0; i < size_-1; i++) {
-                last = last->next();
-            }
-            head = new Node(data, head);
+            tail = create(nullptr, std::forward<Args>(args)...);
+            tail->next(tail);
+            size_++;
+            return tail->data();
         }
-        size_++;
-    }  // inserir no início
+        return link_after(tail, std::forward<Args>(args)...)->data();
+    }
 
     //! Método insert
     /*! O método insert insere dados em uma posição da lista. */
     void insert(const T& data, std::size_t index) {
-        if (index < 0 || index > size_) {
+        emplace(index, data);
+    }  // inserir na posição
+
+    //! Método insert
+    /*! O método insert move dados para uma posição da lista. */
+    void insert(T&& data, std::size_t index) {
+        emplace(index, std::move(data));
+    }
+
+    //! Método emplace
+    /*! O método emplace constrói um dado em uma posição da lista a partir
+     *  dos argumentos. */
+    template<typename... Args>
+    T& emplace(std::size_t index, Args&&... args) {
+        if (index > size_) {
             throw(std::out_of_range("A posição não existe."));
         }
         if (index == 0) {
-            push_front(data);
+            return emplace_front(std::forward<Args>(args)...);
         } else if (index == size_) {
-            push_back(data);
-        } else {
-            Node *n = new Node(data);
-            Node *last = head;
-            for (int i = 1; i < index; i++) {
-                last = last->next();
-            }
-            n->next(last->next());
-            last->next(n);
-            size_++;
+            return emplace_back(std::forward<Args>(args)...);
         }
-    }  // inserir na posição
+        Node *n = link_after(before(index), std::forward<Args>(args)...);
+        return n->data();
+    }
 
     //! Método insert_sorted
     /*! O método insert_sorted insere dados em ordem na lista. */
     void insert_sorted(const T& data) {
-        if (empty() || (data < head->data())) {
-            return push_front(data);
-        } else {
-            Node *n = head;
-            int i = 0;
-            while ((i < size_) && (data > n->data())) {
-                i++;
-                n = n->next();
-            }
-            insert(data, i);
-        }
+        link_sorted(sorted_before(data), data);
     }  // inserir em ordem
 
+    //! Método insert_sorted
+    /*! O método insert_sorted move dados para a posição ordenada. */
+    void insert_sorted(T&& data) {
+        link_sorted(sorted_before(data), std::move(data));
+    }
+
     //! Método at
     /*! O método at acessa um dado de um indice. */
     T& at(std::size_t index) {
         if (index >= size_) {
             throw(std::out_of_range("A posição não existe."));
         }
-        Node *n = head;
-        for (int i = 0; i < index; i++) {
-            n = n->next();
-        }
-        return n->data();
+        return before(index)->next()->data();
     }  // acessar em um indice (com checagem de limites)
 
     //! Método at
@@ -114,11 +183,7 @@ class CircularList {
         if (index >= size_) {
             throw(std::out_of_range("A posição não existe."));
         }
-        Node *n = head;
-        for (int i = 0; i < index; i++) {
-            n = n->next();
-        }
-        return n->data();
+        return before(index)->next()->data();
     }  // versão const do acesso ao indice
 
     //! Método pop
@@ -127,25 +192,10 @@ class CircularList {
         if (empty()) {
             throw(std::out_of_range("A lista está vazia."));
         }
-        if (index < 0 || index >= size_) {
+        if (index >= size_) {
             throw(std::out_of_range("A posição não existe."));
         }
-        if (size_ == 1 || index == 0) {
-            return pop_front();
-        }
-        if (index == size_-1) {
-            return pop_back();
-        }
-        Node *previous = head;
-        for (int i = 1; i < index; i++) {
-            previous = previous->next();
-        }
-        auto old = previous->next();
-        T back = old->data();
-        previous->next(old->next());
-        size_--;
-        delete old;
-        return back;
+        return unlink_after(before(index));
     }  // retirar da posição
 
     //! Método pop_back
@@ -154,19 +204,7 @@ class CircularList {
         if (empty()) {
             throw(std::out_of_range("A lista está vazia."));
         }
-        if (size_ == 1) {
-            return pop_front();
-        }
-        Node *n = head;
-        for (int i = 2; i < size_; i++) {
-            n = n->next();
-        }
-        auto old = n->next();
-        T back = old->data();
-        n->next(head);
-        delete old;
-        size_--;
-        return back;
+        return unlink_after(before(size_-1));
     }  // retirar do fim
 
     //! Método pop_front
@@ -175,18 +213,8 @@ class CircularList {
         if (empty()) {
             throw(std::out_of_range("A lista está vazia."));
         }
-        auto old = head;
-        T back = old->data();
-        head = old->next();
-        Node *end = head;
-        for (int i = 1; i < size_; i++) {
-            end = end->next();
-        }
-        end = end->next();
-        delete old;
-        size_--;
-        return back;
-    }  // retirar do início
+        return unlink_after(tail);
+    }  // retirar do início em O(1)
 
     //! Método remove
     /*! O método remove exclui um dado da lista. */
@@ -194,17 +222,26 @@ class CircularList {
         if (empty()) {
             throw(std::out_of_range("A lista está vazia."));
         } else {
-            Node *n = head;
-            for (int i = 0; i < size_; i++) {
-                if (data == n->data()) {
-                    pop(i);
+            Node *previous = tail;
+            for (std::size_t i = 0; i < size_; i++) {
+                if (data == previous->next()->data()) {
+                    unlink_after(previous);
                     return;
                 }
-                n = n->next();
+                previous = previous->next();
             }
         }
     }  // remover dado específico
 
+    //! Método rotate
+    /*! O método rotate avança o início da lista em uma posição: o primeiro
+     *  dado passa a ser o último. */
+    void rotate() {
+        if (!empty()) {
+            tail = tail->next();
+        }
+    }  // próxima vez no rodízio
+
     //! Método empty
     /*! O método empty verifica se a lista está vazia. */
     bool empty() const {
@@ -223,8 +260,8 @@ class CircularList {
         if (empty()) {
             throw(std::out_of_range("A lista está vazia."));
         }
-        Node *n = head;
-        for (int i = 0; i < size_; i++) {
+        Node *n = tail->next();
+        for (std::size_t i = 0; i < size_; i++) {
             if (data == n->data()) {
                 return (i);
             }
@@ -239,17 +276,89 @@ class CircularList {
         return size_;
     }  // tamanho da lista
 
+    //! Método begin
+    /*! O método begin retorna um iterador para o primeiro dado. */
+    iterator begin() {
+        return iterator(this, tail, first());
+    }
+
+    //! Método end
+    /*! O método end retorna o iterador que sucede o último dado; no anel,
+     *  ele não aponta para nenhum nodo. */
+    iterator end() {
+        return iterator(this, tail, nullptr);
+    }
+
+    //! Método begin
+    /*! O método begin retorna um iterador constante para o primeiro dado. */
+    const_iterator begin() const {
+        return const_iterator(this, tail, first());
+    }
+
+    //! Método end
+    /*! O método end retorna o iterador constante após o último dado. */
+    const_iterator end() const {
+        return const_iterator(this, tail, nullptr);
+    }
+
+    //! Método insert_after
+    /*! O método insert_after insere um dado após o cursor em O(1) e retorna
+     *  um cursor para ele. */
+    iterator insert_after(const_iterator position, const T& data) {
+        return emplace_after(position, data);
+    }
+
+    //! Método insert_after
+    /*! O método insert_after move um dado para depois do cursor em O(1). */
+    iterator insert_after(const_iterator position, T&& data) {
+        return emplace_after(position, std::move(data));
+    }
+
+    //! Método emplace_after
+    /*! O método emplace_after constrói um dado após o cursor em O(1) e
+     *  retorna um cursor para ele. */
+    template<typename... Args>
+    iterator emplace_after(const_iterator position, Args&&... args) {
+        if (position.node_ == nullptr) {
+            throw(std::out_of_range("A posição não existe."));
+        }
+        Node *n = link_after(position.node_, std::forward<Args>(args)...);
+        if (position.node_ == tail) {
+            tail = n;
+        }
+        return iterator(this, position.node_, n);
+    }
+
+    //! Método erase_at
+    /*! O método erase_at remove o dado do cursor em O(1) e retorna um cursor
+     *  para o dado seguinte. Inserções não invalidam cursores: se uma delas
+     *  mudou o nodo anterior ao do cursor, ele é procurado de novo em O(n).
+     *  Como cada cursor guarda o nodo anterior, qualquer remoção invalida
+     *  os demais cursores da lista; continue pelo cursor retornado. */
+    iterator erase_at(const_iterator position) {
+        if (position.node_ == nullptr) {
+            throw(std::out_of_range("A posição não existe."));
+        }
+        Node *previous = position.previous_;
+        if (previous->next() != position.node_) {
+            previous = find_previous(position.node_);
+        }
+        bool last = (position.node_ == tail);
+        unlink_after(previous);
+        if (empty() || last) {
+            return end();
+        }
+        return iterator(this, previous, previous->next());
+    }
+
  private:
     class Node {  // Elemento
      public:
-        explicit Node(const T& data):
-            data_{data}
-        {}
-
-        Node(const T& data, Node* next):
-            data_{data},
+        template<typename... Args>
+        explicit Node(Node* next, Args&&... args):
+            data_(std::forward<Args>(args)...),
             next_{next}
-        {}
+        {}  // dado construído no próprio nodo
 
         T& data() {  // getter: dado
             return data_;
@@ -276,8 +385,159 @@ class CircularList {
         Node* next_{nullptr};
     };
 
-    Node* head{nullptr};
+    template<typename V>
+    class Iterator {  // end() não tem nodo: o anel acaba no último da lista
+     public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = V*;
+        using reference = V&;
+
+        Iterator() = default;
+
+        Iterator(const CircularList* list, Node* previous, Node* node):
+            list_{list},
+            previous_{previous},
+            node_{node}
+        {}
+
+        template<typename W, typename = typename std::enable_if<
+            std::is_same<W, T>::value && !std::is_same<V, T>::value>::type>
+        Iterator(const Iterator<W>& other):  // iterator -> const_iterator
+            list_{other.list_},
+            previous_{other.previous_},
+            node_{other.node_}
+        {}
+
+        reference operator*() const {
+            return node_->data();
+        }
+
+        pointer operator->() const {
+            return &node_->data();
+        }
+
+        Iterator& operator++() {
+            previous_ = node_;
+            node_ = (node_ != list_->tail ? node_->next() : nullptr);
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return node_ == other.node_;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return node_ != other.node_;
+        }
+
+     private:
+        friend class CircularList;
+        template<typename> friend class Iterator;
+
+        const CircularList* list_{nullptr};
+        Node* previous_{nullptr};
+        Node* node_{nullptr};
+    };
+
+    Node* first() const {
+        return (tail != nullptr ? tail->next() : nullptr);
+    }  // o nodo-cabeça é o sucessor do último
+
+    Node* before(std::size_t index) const {
+        Node *previous = tail;
+        for (std::size_t i = 0; i < index; i++) {
+            previous = previous->next();
+        }
+        return previous;
+    }  // nodo anterior à posição index
+
+    template<typename... Args>
+    Node* link_after(Node* previous, Args&&... args) {
+        Node *n = create(previous->next(), std::forward<Args>(args)...);
+        previous->next(n);
+        size_++;
+        return n;
+    }
+
+    Node* sorted_before(const T& data) const {
+        Node *previous = tail;
+        for (std::size_t i = 0; i < size_; i++) {
+            if (!(data > previous->next()->data())) {
+                return previous;
+            }
+            previous = previous->next();
+        }
+        return nullptr;
+    }  // nodo após o qual data fica em ordem (nullptr: após o último)
+
+    template<typename U>
+    void link_sorted(Node* previous, U&& data) {
+        if (previous == nullptr) {
+            emplace_back(std::forward<U>(data));  // maior que todos
+        } else {
+            link_after(previous, std::forward<U>(data));
+        }
+    }
+
+    Node* find_previous(const Node* n) const {
+        Node *previous = tail;
+        for (std::size_t i = 0; i < size_; i++) {
+            if (previous->next() == n) {
+                return previous;
+            }
+            previous = previous->next();
+        }
+        throw(std::out_of_range("A posição não existe."));
+    }  // percorre o anel uma vez a partir do último nodo
+
+    T unlink_after(Node* previous) {
+        Node *out = previous->next();
+        T back = std::move(out->data());
+        if (out == previous) {
+            tail = nullptr;  // era o único nodo
+        } else {
+            previous->next(out->next());
+            if (out == tail) {
+                tail = previous;
+            }
+        }
+        size_--;
+        dispose(out);
+        return back;
+    }
+
+    using NodeAlloc =
+        typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAlloc>;
+
+    template<typename... Args>
+    Node* create(Args&&... args) {
+        Node *n = NodeTraits::allocate(alloc_, 1);
+        try {
+            NodeTraits::construct(alloc_, n, std::forward<Args>(args)...);
+        } catch (...) {
+            NodeTraits::deallocate(alloc_, n, 1);
+            throw;
+        }
+        return n;
+    }  // nodo construído na memória do alocador
+
+    void dispose(Node* n) {
+        NodeTraits::destroy(alloc_, n);
+        NodeTraits::deallocate(alloc_, n, 1);
+    }
+
+    Node* tail{nullptr};  // último nodo; tail->next() é o primeiro
     std::size_t size_{0u};
+    NodeAlloc alloc_;
 };
 
 }  // namespace structures
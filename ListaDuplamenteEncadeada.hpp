@@ -1,142 +1,209 @@
 #ifndef STRUCTURES_DOUBLY_LINKED_LIST_H
 #define STRUCTURES_DOUBLY_LINKED_LIST_H
 
+#include <cstddef>  // std::ptrdiff_t
 #include <cstdint>  // std::size_t
+#include <iterator>  // std::bidirectional_iterator_tag
+#include <memory>  // std::allocator_traits
 #include <stdexcept>  // C++ exceptions
+#include <type_traits>  // std::enable_if, std::is_same
+#include <utility>  // std::move, std::forward, std::swap
+
+#include "./Alocador.hpp"
 
 namespace structures {
 
 //! Classe DoublyLinkedList
 /*! A classe DoublyLinkedList implementa uma lista duplamente encadeada. */
 
-template<typename T>
+template<typename T, typename Alloc = std::allocator<T>>
 class DoublyLinkedList {
+    class Node;
+    template<typename V> class Iterator;
+
  public:
+    using iterator = Iterator<T>;
+    using const_iterator = Iterator<const T>;
+
     DoublyLinkedList() = default;
 
-    ~DoublyLinkedList() {
-        Node *current, *previous;
-        current = head;
-        while (current != nullptr) {
-            previous = current;
-            current = current->next();
-            delete previous;
+    explicit DoublyLinkedList(const Alloc& alloc):
+        alloc_{alloc}
+    {}  // nodos alocados por alloc
+
+    DoublyLinkedList(const DoublyLinkedList& other):
+        alloc_{NodeTraits::select_on_container_copy_construction(other.alloc_)}
+    {
+        for (const T& data : other) {
+            push_back(data);
         }
+    }  // cópia na mesma ordem
+
+    DoublyLinkedList(DoublyLinkedList&& other) noexcept:
+        head{other.head},
+        tail{other.tail},
+        size_{other.size_},
+        alloc_{std::move(other.alloc_)}
+    {
+        other.head = nullptr;
+        other.tail = nullptr;
+        other.size_ = 0;
+    }  // toma os nodos de other
+
+    DoublyLinkedList& operator=(DoublyLinkedList other) {
+        swap(other);
+        return *this;
+    }  // cópia ou movimento conforme o argumento
+
+    ~DoublyLinkedList() {
+        clear();
+    }
+
+    //! Método swap
+    /*! O método swap troca o conteúdo de duas listas em O(1). */
+    void swap(DoublyLinkedList& other) noexcept {
+        std::swap(head, other.head);
+        std::swap(tail, other.tail);
+        std::swap(size_, other.size_);
+        std::swap(alloc_, other.alloc_);
     }
 
     //! Método clear
     /*! O método clear apaga os dados da lista. */
     void clear() {
-        Node *previous = head;
-        while (previous != nullptr) {
-            previous = previous->next();
-            pop_front();
+        if (!release_arena(alloc_)) {
+            Node *current = head;
+            while (current != nullptr) {
+                Node *previous = current;
+                current = current->next();
+                dispose(previous);
+            }
         }
+        head = nullptr;
+        tail = nullptr;
         size_ = 0;
-    }
+    }  // com arena, todos os nodos de uma vez
 
     //! Método push_back
     /*! O método push_back insere dados no fim da lista. */
     void push_back(const T& data) {
-        insert(data, size_);
+        emplace_back(data);
     }  // insere no fim
 
+    //! Método push_back
+    /*! O método push_back move dados para o fim da lista. */
+    void push_back(T&& data) {
+        emplace_back(std::move(data));
+    }
+
+    //! Método emplace_back
+    /*! O método emplace_back constrói um dado no fim da lista a partir dos
+     *  argumentos. */
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        Node *n = create(tail, nullptr, std::forward<Args>(args)...);
+        if (empty()) {
+            head = n;
+        } else {
+            tail->next(n);
+        }
+        tail = n;
+        size_++;
+        return n->data();
+    }
+
     //! Método push_front
     /*! O método push_front insere dados no começo da lista. */
     void push_front(const T& data) {
-        Node *n = new Node(data);
-        if (n == nullptr) {
-            throw(std::out_of_range("A lista está cheia."));
+        emplace_front(data);
+    }  // insere no início
+
+    //! Método push_front
+    /*! O método push_front move dados para o começo da lista. */
+    void push_front(T&& data) {
+        emplace_front(std::move(data));
+    }
+
+    //! Método emplace_front
+    /*! O método emplace_front constrói um dado no começo da lista a partir
+     *  dos argumentos. */
+    template<typename... Args>
+    T& emplace_front(Args&&... args) {
+        Node *n = create(nullptr, head, std::forward<Args>(args)...);
+        if (empty()) {
+            tail = n;
         } else {
-            n->next(head);
-            n->prev(nullptr);
-            head = n;
-            if (n->next() != nullptr) {
-                n->next()->prev(n);
-            }
-            size_++;
+            head->prev(n);
         }
-    }  // insere no início
+        head = n;
+        size_++;
+        return n->data();
+    }
 
     //! Método insert
     /*! O método insert insere dados em uma posição da lista. */
     void insert(const T& data, std::size_t index) {
+        emplace(index, data);
+    }  // insere na posição
+
+    //! Método insert
+    /*! O método insert move dados para uma posição da lista. */
+    void insert(T&& data, std::size_t index) {
+        emplace(index, std::move(data));
+    }
+
+    //! Método emplace
+    /*! O método emplace constrói um dado em uma posição da lista a partir
+     *  dos argumentos. */
+    template<typename... Args>
+    T& emplace(std::size_t index, Args&&... args) {
         if (index > size_) {
             throw(std::out_of_range("A posição não existe."));
-        } else {
-            if (index == 0) {
-                push_front(data);
-            } else {
-                Node *n = new Node(data, head);
-                if (n == nullptr) {
-                    throw(std::out_of_range("A lista está cheia."));
-                } else {
-                    Node *previous = head;
-                    for (int i = 0; i < index-1; i++) {
-                        previous = previous->next();
-                    }
-                    if (n->next() != nullptr) {
-                        n->next(previous->next());
-                    }
-                    if (n->next() != nullptr) {
-                        n->next()->prev(n);
-                    }
-                    previous->next(n);
-                    size_++;
-                }
-            }
+        } else if (index == 0) {
+            return emplace_front(std::forward<Args>(args)...);
+        } else if (index == size_) {
+            return emplace_back(std::forward<Args>(args)...);
         }
-    }  // insere na posição
+        Node *n = link_before(node_at(index), std::forward<Args>(args)...);
+        return n->data();
+    }
 
     //! Método insert_sorted
     /*! O método insert_sorted insere dados em ordem na lista. */
     void insert_sorted(const T& data) {
-        if (empty() || head->data() > data) {
-            push_front(data);
-        } else {
-            Node *n = head;
-            while ((n != nullptr) && (n->next() != nullptr)
-                   && (data > n->next()->data())) {
-                n = n->next();
-            }
-            n->next(new Node(data, n->next()));
-            size_++;
-        }
+        link_sorted(sorted_next(data), data);
     }  // insere em ordem
 
+    //! Método insert_sorted
+    /*! O método insert_sorted move dados para a posição ordenada. */
+    void insert_sorted(T&& data) {
+        link_sorted(sorted_next(data), std::move(data));
+    }
+
     //! Método pop
     /*! O método pop remove um dado de uma posição. */
     T pop(std::size_t index) {
-        T back;
         if (empty()) {
             throw(std::out_of_range("A lista está vazia."));
         }
         if (index >= size_) {
             throw(std::out_of_range("A posição não existe."));
         }
-        if (index == 0) {
-            back = pop_front();
-        } else {
-            Node *previous = head;
-            for (int i = 1; i < index; i++) {
-                previous = previous->next();
-            }
-            Node *del = previous->next();
-            back = del->data();
-            previous->next(del->next());
-            if (del->next() != nullptr) {
-                del->next()->prev(previous);
-            }
-            size_--;
-            delete del;
-        }
+        Node *out = node_at(index);
+        T back = std::move(out->data());
+        unlink(out);
         return back;
     }  // retira da posição
 
     //! Método pop_back
     /*! O método pop_back remove dados do fim da lista. */
     T pop_back() {
-        return pop(size_-1);
+        if (empty()) {
+            throw(std::out_of_range("A lista está vazia."));
+        }
+        T back = std::move(tail->data());
+        unlink(tail);
+        return back;
     }  // retira do fim
 
     //! Método pop_front
@@ -145,14 +212,8 @@ class DoublyLinkedList {
         if (empty()) {
             throw(std::out_of_range("A lista está vazia."));
         }
-        Node *out = head;
-        T back = out->data();
-        head = out->next();
-        if (head != nullptr) {
-            head->prev(nullptr);
-        }
-        size_--;
-        delete out;
+        T back = std::move(head->data());
+        unlink(head);
         return back;
     }  // retira do início
 
@@ -162,22 +223,10 @@ class DoublyLinkedList {
         if (empty()) {
             throw(std::out_of_range("A lista está vazia."));
         } else {
-            Node *previous = head;
-            Node *current = head->next();
-            if (data == previous->data()) {
-                head = previous->next();
-                size_--;
-                delete previous;
-            } else {
-                for (int i = 0; i < size_; i++) {
-                    if (data == current->data()) {
-                        previous->next(current->next());
-                        size_--;
-                        delete current;
-                        return;
-                    }
-                    previous = previous->next();
-                    current = current->next();
+            for (Node *n = head; n != nullptr; n = n->next()) {
+                if (data == n->data()) {
+                    unlink(n);
+                    return;
                 }
             }
         }
@@ -208,11 +257,7 @@ class DoublyLinkedList {
         if (index >= size_) {
             throw(std::out_of_range("A posição não existe."));
         }
-        Node *n = head;
-        for (int i = 0; i < index; i++) {
-            n = n->next();
-        }
-        return n->data();
+        return node_at(index)->data();
     }  // acesso a um elemento (checando limites)
 
     //! Método at
@@ -221,11 +266,7 @@ class DoublyLinkedList {
         if (index >= size_) {
             throw(std::out_of_range("A posição não existe."));
         }
-        Node *n = head;
-        for (int i = 0; i < index; i++) {
-            n = n->next();
-        }
-        return n->data();
+        return node_at(index)->data();
     }  // getter constante a um elemento
 
     //! Método find
@@ -247,23 +288,82 @@ class DoublyLinkedList {
         return size_;
     }  // tamanho
 
- private:
-    class Node {
-     public:
-        explicit Node(const T& data) {
-            data_ = data;
-        }
+    //! Método begin
+    /*! O método begin retorna um iterador para o primeiro dado. */
+    iterator begin() {
+        return iterator(this, head);
+    }
+
+    //! Método end
+    /*! O método end retorna o iterador que sucede o último dado. */
+    iterator end() {
+        return iterator(this, nullptr);
+    }
+
+    //! Método begin
+    /*! O método begin retorna um iterador constante para o primeiro dado. */
+    const_iterator begin() const {
+        return const_iterator(this, head);
+    }
 
-        Node(const T& data, Node* next) {
-            data_ = data;
-            next_ = next;
+    //! Método end
+    /*! O método end retorna o iterador constante após o último dado. */
+    const_iterator end() const {
+        return const_iterator(this, nullptr);
+    }
+
+    //! Método insert_after
+    /*! O método insert_after insere um dado após o cursor em O(1) e retorna
+     *  um cursor para ele. */
+    iterator insert_after(const_iterator position, const T& data) {
+        return emplace_after(position, data);
+    }
+
+    //! Método insert_after
+    /*! O método insert_after move um dado para depois do cursor em O(1). */
+    iterator insert_after(const_iterator position, T&& data) {
+        return emplace_after(position, std::move(data));
+    }
+
+    //! Método emplace_after
+    /*! O método emplace_after constrói um dado após o cursor em O(1) e
+     *  retorna um cursor para ele. */
+    template<typename... Args>
+    iterator emplace_after(const_iterator position, Args&&... args) {
+        if (position.node_ == nullptr) {
+            throw(std::out_of_range("A posição não existe."));
+        }
+        if (position.node_ == tail) {
+            emplace_back(std::forward<Args>(args)...);
+            return iterator(this, tail);
         }
+        Node *n = link_before(position.node_->next(),
+                              std::forward<Args>(args)...);
+        return iterator(this, n);
+    }
 
-        Node(const T& data, Node* prev, Node* next) {
-            data_ = data;
-            next_ = next;
-            prev_ = prev;
+    //! Método erase_at
+    /*! O método erase_at remove o dado do cursor em O(1) e retorna um cursor
+     *  para o dado seguinte. */
+    iterator erase_at(const_iterator position) {
+        Node *out = position.node_;
+        if (out == nullptr) {
+            throw(std::out_of_range("A posição não existe."));
         }
+        Node *next = out->next();
+        unlink(out);
+        return iterator(this, next);
+    }
+
+ private:
+    class Node {
+     public:
+        template<typename... Args>
+        Node(Node* prev, Node* next, Args&&... args):
+            data_(std::forward<Args>(args)...),
+            prev_{prev},
+            next_{next}
+        {}  // dado construído no próprio nodo
 
         T& data() {
             return data_;
@@ -303,8 +403,159 @@ class DoublyLinkedList {
         Node* next_;
     };
 
+    template<typename V>
+    class Iterator {
+     public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = V*;
+        using reference = V&;
+
+        Iterator() = default;
+
+        Iterator(const DoublyLinkedList* list, Node* node):
+            list_{list},
+            node_{node}
+        {}
+
+        template<typename W, typename = typename std::enable_if<
+            std::is_same<W, T>::value && !std::is_same<V, T>::value>::type>
+        Iterator(const Iterator<W>& other):  // iterator -> const_iterator
+            list_{other.list_},
+            node_{other.node_}
+        {}
+
+        reference operator*() const {
+            return node_->data();
+        }
+
+        pointer operator->() const {
+            return &node_->data();
+        }
+
+        Iterator& operator++() {
+            node_ = node_->next();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        Iterator& operator--() {
+            node_ = (node_ == nullptr ? list_->tail : node_->prev());
+            return *this;
+        }  // end() recua para o último nodo
+
+        Iterator operator--(int) {
+            Iterator old = *this;
+            --*this;
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return node_ == other.node_;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return node_ != other.node_;
+        }
+
+     private:
+        friend class DoublyLinkedList;
+        template<typename> friend class Iterator;
+
+        const DoublyLinkedList* list_{nullptr};
+        Node* node_{nullptr};
+    };
+
+    Node* node_at(std::size_t index) const {
+        Node *n;
+        if (index < size_/2) {
+            n = head;
+            for (std::size_t i = 0; i < index; i++) {
+                n = n->next();
+            }
+        } else {
+            n = tail;
+            for (std::size_t i = size_-1; i > index; i--) {
+                n = n->prev();
+            }
+        }
+        return n;
+    }  // percorre a partir da ponta mais próxima
+
+    template<typename... Args>
+    Node* link_before(Node* next, Args&&... args) {
+        Node *n = create(next->prev(), next, std::forward<Args>(args)...);
+        next->prev()->next(n);
+        next->prev(n);
+        size_++;
+        return n;
+    }  // next não pode ser o nodo-cabeça
+
+    Node* sorted_next(const T& data) const {
+        Node *n = head;
+        while ((n != nullptr) && (data > n->data())) {
+            n = n->next();
+        }
+        return n;
+    }  // primeiro nodo que não é menor que data
+
+    template<typename U>
+    void link_sorted(Node* next, U&& data) {
+        if (next == nullptr) {
+            emplace_back(std::forward<U>(data));
+        } else if (next == head) {
+            emplace_front(std::forward<U>(data));
+        } else {
+            link_before(next, std::forward<U>(data));
+        }
+    }
+
+    void unlink(Node* n) {
+        if (n->prev() != nullptr) {
+            n->prev()->next(n->next());
+        } else {
+            head = n->next();
+        }
+        if (n->next() != nullptr) {
+            n->next()->prev(n->prev());
+        } else {
+            tail = n->prev();
+        }
+        size_--;
+        dispose(n);
+    }
+
+    using NodeAlloc =
+        typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAlloc>;
+
+    template<typename... Args>
+    Node* create(Args&&... args) {
+        Node *n = NodeTraits::allocate(alloc_, 1);
+        try {
+            NodeTraits::construct(alloc_, n, std::forward<Args>(args)...);
+        } catch (...) {
+            NodeTraits::deallocate(alloc_, n, 1);
+            throw;
+        }
+        return n;
+    }  // nodo construído na memória do alocador
+
+    void dispose(Node* n) {
+        NodeTraits::destroy(alloc_, n);
+        NodeTraits::deallocate(alloc_, n, 1);
+    }
+
     Node* head{nullptr};
+    Node* tail{nullptr};
     std::size_t size_{0u};
+    NodeAlloc alloc_;
 };
 
 }  // namespace structures
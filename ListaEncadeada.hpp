@@ -1,90 +1,197 @@
 #ifndef STRUCTURES_LINKED_LIST_H
 #define STRUCTURES_LINKED_LIST_H
 
+#include <cstddef>  // std::ptrdiff_t
 #include <cstdint>  // std::size_t
+#include <iterator>  // std::forward_iterator_tag
+#include <memory>  // std::allocator_traits
 #include <stdexcept>  // C++ exceptions
+#include <type_traits>  // std::enable_if, std::is_same
+#include <utility>  // std::move, std::forward, std::swap
+
+#include "./Alocador.hpp"
 
 namespace structures {
 
 //! Classe LinkedList
 /*! A classe LinkedList implementa uma lista encadeada genérica. */
 
-template<typename T>
+template<typename T, typename Alloc = std::allocator<T>>
 class LinkedList {
+    class Node;
+    template<typename V> class Iterator;
+
  public:
+    using iterator = Iterator<T>;
+    using const_iterator = Iterator<const T>;
+
     LinkedList() = default;  // construtor padrão
 
-    ~LinkedList() {
-        Node *current, *previous;
-        current = head;
-        while (current != nullptr) {
-            previous = current;
-            current = current->next();
-            delete previous;
+    explicit LinkedList(const Alloc& alloc):
+        alloc_{alloc}
+    {}  // nodos alocados por alloc
+
+    LinkedList(const LinkedList& other):
+        alloc_{NodeTraits::select_on_container_copy_construction(other.alloc_)}
+    {
+        for (const T& data : other) {
+            push_back(data);
         }
+    }  // cópia na mesma ordem
+
+    LinkedList(LinkedList&& other) noexcept:
+        head{other.head},
+        tail{other.tail},
+        size_{other.size_},
+        alloc_{std::move(other.alloc_)}
+    {
+        other.head = nullptr;
+        other.tail = nullptr;
+        other.size_ = 0;
+    }  // toma os nodos de other
+
+    LinkedList& operator=(LinkedList other) {
+        swap(other);
+        return *this;
+    }  // cópia ou movimento conforme o argumento
+
+    ~LinkedList() {
+        clear();
     }  // destrutor
 
+    //! Método swap
+    /*! O método swap troca o conteúdo de duas listas em O(1). */
+    void swap(LinkedList& other) noexcept {
+        std::swap(head, other.head);
+        std::swap(tail, other.tail);
+        std::swap(size_, other.size_);
+        std::swap(alloc_, other.alloc_);
+    }
+
     //! Método clear
     /*! O método clear apaga os dados da lista. */
     void clear() {
-        Node *previous = head;
-        while (previous != nullptr) {
-            previous = previous->next();
-            pop_front();
+        if (!release_arena(alloc_)) {
+            Node *current = head;
+            while (current != nullptr) {
+                Node *previous = current;
+                current = current->next();
+                dispose(previous);
+            }
         }
+        head = nullptr;
+        tail = nullptr;
         size_ = 0;
-    }  // limpar lista
+    }  // limpar lista; com arena, todos os nodos de uma vez
 
     //! Método push_back
     /*! O método push_back insere dados no fim da lista. */
     void push_back(const T& data) {
-        insert(data, size_);
-    }  // inserir no fim
+        emplace_back(data);
+    }  // inserir no fim em O(1)
+
+    //! Método push_back
+    /*! O método push_back move dados para o fim da lista. */
+    void push_back(T&& data) {
+        emplace_back(std::move(data));
+    }
+
+    //! Método emplace_back
+    /*! O método emplace_back constrói um dado no fim da lista a partir dos
+     *  argumentos. */
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        Node *n = create(nullptr, std::forward<Args>(args)...);
+        if (empty()) {
+            head = n;
+        } else {
+            tail->next(n);
+        }
+        tail = n;
+        size_++;
+        return n->data();
+    }
 
     //! Método push_front
     /*! O método push_front insere dados no começo da lista. */
     void push_front(const T& data) {
-        head = new Node(data, head);
-        size_++;
+        emplace_front(data);
     }  // inserir no início
 
+    //! Método push_front
+    /*! O método push_front move dados para o começo da lista. */
+    void push_front(T&& data) {
+        emplace_front(std::move(data));
+    }
+
+    //! Método emplace_front
+    /*! O método emplace_front constrói um dado no começo da lista a partir
+     *  dos argumentos. */
+    template<typename... Args>
+    T& emplace_front(Args&&... args) {
+        head = create(head, std::forward<Args>(args)...);
+        if (tail == nullptr) {
+            tail = head;
+        }
+        size_++;
+        return head->data();
+    }
+
     //! Método insert
     /*! O método insert insere dados em uma posição da lista. */
     void insert(const T& data, std::size_t index) {
+        emplace(index, data);
+    }  // inserir na posição
+
+    //! Método insert
+    /*! O método insert move dados para uma posição da lista. */
+    void insert(T&& data, std::size_t index) {
+        emplace(index, std::move(data));
+    }
+
+    //! Método emplace
+    /*! O método emplace constrói um dado em uma posição da lista a partir
+     *  dos argumentos. */
+    template<typename... Args>
+    T& emplace(std::size_t index, Args&&... args) {
         if (index > size_) {
             throw(std::out_of_range("A posição não existe."));
-        } else {
-            if (index == 0) {
-                push_front(data);
-            } else {
-                Node *n = new Node(data);
-                Node *previous = head;
-                for (auto i = 1u; i < index; ++i) {
-                    previous = previous->next();
-                }
-                n->next(previous->next());
-                previous->next(n);
-                size_++;
-            }
         }
-    }  // inserir na posição
+        if (index == 0) {
+            return emplace_front(std::forward<Args>(args)...);
+        }
+        if (index == size_) {
+            return emplace_back(std::forward<Args>(args)...);
+        }  // o fim está na cauda: O(1)
+        Node *previous = head;
+        for (auto i = 1u; i < index; ++i) {
+            previous = previous->next();
+        }
+        return link_after(previous, std::forward<Args>(args)...)->data();
+    }
 
     //! Método insert_sorted
     /*! O método insert_sorted insere dados em ordem na lista. */
     void insert_sorted(const T& data) {
-        if (empty() || head->data() > data) {
-            push_front(data);
+        Node *previous = sorted_before(data);
+        if (previous == nullptr) {
+            emplace_front(data);
         } else {
-            Node *current = head;
-            while ((current != nullptr) && (current->next() != nullptr)
-                   && (data > current->next()->data())) {
-                current = current->next();
-            }
-            current->next(new Node(data, current->next()));
-            size_++;
+            link_after(previous, data);
         }
     }  // inserir em ordem
 
+    //! Método insert_sorted
+    /*! O método insert_sorted move dados para a posição ordenada. */
+    void insert_sorted(T&& data) {
+        Node *previous = sorted_before(data);
+        if (previous == nullptr) {
+            emplace_front(std::move(data));
+        } else {
+            link_after(previous, std::move(data));
+        }
+    }
+
     //! Método at
     /*! O método at acessa um dado de um indice. */
     T& at(std::size_t index) {
@@ -101,7 +208,6 @@ class LinkedList {
     //! Método pop
     /*! O método pop remove um dado de uma posição. */
     T pop(std::size_t index) {
-        T back;
         if (empty()) {
             throw(std::out_of_range("A lista está vazia."));
         }
@@ -109,19 +215,13 @@ class LinkedList {
             throw(std::out_of_range("A posição não existe."));
         }
         if (index == 0) {
-            back = pop_front();
-        } else {
-            Node *previous = head;
-            for (int i = 1; i < index; i++) {
-                previous = previous->next();
-            }
-            Node *del = previous->next();
-            back = del->data();
-            previous->next(del->next());
-            size_--;
-            delete del;
+            return pop_front();
         }
-        return back;
+        Node *previous = head;
+        for (std::size_t i = 1; i < index; i++) {
+            previous = previous->next();
+        }
+        return unlink_after(previous);
     }  // retirar da posição
 
     //! Método pop_back
@@ -137,10 +237,13 @@ class LinkedList {
             throw(std::out_of_range("A lista está vazia."));
         }
         Node *out = head;
-        T back = out->data();
+        T back = std::move(out->data());
         head = out->next();
+        if (head == nullptr) {
+            tail = nullptr;
+        }
         size_--;
-        delete out;
+        dispose(out);
         return back;
     }  // retirar do início
 
@@ -150,23 +253,19 @@ class LinkedList {
         if (empty()) {
             throw(std::out_of_range("A lista está vazia."));
         } else {
+            if (data == head->data()) {
+                pop_front();
+                return;
+            }
             Node *previous = head;
             Node *current = head->next();
-            if (data == previous->data()) {
-                head = previous->next();
-                size_--;
-                delete previous;
-            } else {
-                for (int i = 0; i < size_; i++) {
-                    if (data == current->data()) {
-                        previous->next(current->next());
-                        size_--;
-                        delete current;
-                        return;
-                    }
-                    previous = previous->next();
-                    current = current->next();
+            while (current != nullptr) {
+                if (data == current->data()) {
+                    unlink_after(previous);
+                    return;
                 }
+                previous = current;
+                current = current->next();
             }
         }
     }  // remover específico
@@ -209,17 +308,86 @@ class LinkedList {
         return size_;
     }  // tamanho da lista
 
+    //! Método begin
+    /*! O método begin retorna um iterador para o primeiro dado. */
+    iterator begin() {
+        return iterator(nullptr, head);
+    }
+
+    //! Método end
+    /*! O método end retorna o iterador que sucede o último dado. */
+    iterator end() {
+        return iterator(tail, nullptr);
+    }
+
+    //! Método begin
+    /*! O método begin retorna um iterador constante para o primeiro dado. */
+    const_iterator begin() const {
+        return const_iterator(nullptr, head);
+    }
+
+    //! Método end
+    /*! O método end retorna o iterador constante após o último dado. */
+    const_iterator end() const {
+        return const_iterator(tail, nullptr);
+    }
+
+    //! Método insert_after
+    /*! O método insert_after insere um dado após o cursor em O(1) e retorna
+     *  um cursor para ele. */
+    iterator insert_after(const_iterator position, const T& data) {
+        return emplace_after(position, data);
+    }
+
+    //! Método insert_after
+    /*! O método insert_after move um dado para depois do cursor em O(1). */
+    iterator insert_after(const_iterator position, T&& data) {
+        return emplace_after(position, std::move(data));
+    }
+
+    //! Método emplace_after
+    /*! O método emplace_after constrói um dado após o cursor em O(1) e
+     *  retorna um cursor para ele. */
+    template<typename... Args>
+    iterator emplace_after(const_iterator position, Args&&... args) {
+        if (position.node_ == nullptr) {
+            throw(std::out_of_range("A posição não existe."));
+        }
+        Node *n = link_after(position.node_, std::forward<Args>(args)...);
+        return iterator(position.node_, n);
+    }
+
+    //! Método erase_at
+    /*! O método erase_at remove o dado do cursor em O(1) e retorna um cursor
+     *  para o dado seguinte. Inserções não invalidam cursores: se uma delas
+     *  mudou o nodo anterior ao do cursor, ele é procurado de novo em O(n).
+     *  Como cada cursor guarda o nodo anterior, qualquer remoção invalida
+     *  os demais cursores da lista; continue pelo cursor retornado. */
+    iterator erase_at(const_iterator position) {
+        Node *out = position.node_;
+        if (out == nullptr) {
+            throw(std::out_of_range("A posição não existe."));
+        }
+        Node *previous = position.previous_;
+        if ((previous == nullptr ? head : previous->next()) != out) {
+            previous = find_previous(out);
+        }
+        if (previous == nullptr) {
+            pop_front();
+        } else {
+            unlink_after(previous);
+        }
+        return iterator(previous, (previous ? previous->next() : head));
+    }
+
  private:
     class Node {  // Elemento
      public:
-        explicit Node(const T& data):
-            data_{data}
-        {}
-
-        Node(const T& data, Node* next):
-            data_{data},
+        template<typename... Args>
+        explicit Node(Node* next, Args&&... args):
+            data_(std::forward<Args>(args)...),
             next_{next}
-        {}
+        {}  // dado construído no próprio nodo
 
         T& data() {  // getter: dado
             return data_;
@@ -246,16 +414,139 @@ class LinkedList {
         Node* next_{nullptr};
     };
 
-    Node* end() {  // último nodo da lista
-        auto it = head;
-        for (auto i = 1u; i < size(); ++i) {
-            it = it->next();
+    template<typename V>
+    class Iterator {  // cursor: guarda o nodo anterior para remover em O(1)
+     public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = V*;
+        using reference = V&;
+
+        Iterator() = default;
+
+        Iterator(Node* previous, Node* node):
+            previous_{previous},
+            node_{node}
+        {}
+
+        template<typename W, typename = typename std::enable_if<
+            std::is_same<W, T>::value && !std::is_same<V, T>::value>::type>
+        Iterator(const Iterator<W>& other):  // iterator -> const_iterator
+            previous_{other.previous_},
+            node_{other.node_}
+        {}
+
+        reference operator*() const {
+            return node_->data();
+        }
+
+        pointer operator->() const {
+            return &node_->data();
+        }
+
+        Iterator& operator++() {
+            previous_ = node_;
+            node_ = node_->next();
+            return *this;
         }
-        return it;
+
+        Iterator operator++(int) {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return node_ == other.node_;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return node_ != other.node_;
+        }
+
+     private:
+        friend class LinkedList;
+        template<typename> friend class Iterator;
+
+        Node* previous_{nullptr};
+        Node* node_{nullptr};
+    };
+
+    template<typename... Args>
+    Node* link_after(Node* previous, Args&&... args) {
+        Node *n = create(previous->next(), std::forward<Args>(args)...);
+        previous->next(n);
+        if (previous == tail) {
+            tail = n;
+        }
+        size_++;
+        return n;
+    }
+
+    Node* find_previous(const Node* n) const {
+        if (head == n) {
+            return nullptr;
+        }
+        Node *previous = head;
+        while (previous != nullptr && previous->next() != n) {
+            previous = previous->next();
+        }
+        if (previous == nullptr) {
+            throw(std::out_of_range("A posição não existe."));
+        }
+        return previous;
+    }  // nodo anterior a n, ou nullptr se n é o primeiro
+
+    T unlink_after(Node* previous) {
+        Node *out = previous->next();
+        T back = std::move(out->data());
+        previous->next(out->next());
+        if (out == tail) {
+            tail = previous;
+        }
+        size_--;
+        dispose(out);
+        return back;
+    }
+
+    Node* sorted_before(const T& data) const {
+        if (empty() || head->data() > data) {
+            return nullptr;
+        }
+        Node *current = head;
+        while ((current->next() != nullptr)
+               && (data > current->next()->data())) {
+            current = current->next();
+        }
+        return current;
+    }  // nodo após o qual data fica em ordem (nullptr: início)
+
+    using NodeAlloc =
+        typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAlloc>;
+
+    template<typename... Args>
+    Node* create(Args&&... args) {
+        Node *n = NodeTraits::allocate(alloc_, 1);
+        try {
+            NodeTraits::construct(alloc_, n, std::forward<Args>(args)...);
+        } catch (...) {
+            NodeTraits::deallocate(alloc_, n, 1);
+            throw;
+        }
+        return n;
+    }  // nodo construído na memória do alocador
+
+    void dispose(Node* n) {
+        NodeTraits::destroy(alloc_, n);
+        NodeTraits::deallocate(alloc_, n, 1);
     }
 
     Node* head{nullptr};
+    Node* tail{nullptr};  // último nodo da lista
     std::size_t size_{0u};
+    NodeAlloc alloc_;
 };
 
 }  // namespace structures
@@ -2,7 +2,10 @@
 #define STRUCTURES_ARRAY_STACK_H
 
 #include <cstdint>  // std::size_t
+#include <memory>  // std::allocator
+#include <new>  // placement new
 #include <stdexcept>  // C++ exceptions
+#include <utility>  // std::move
 
 namespace structures {
 
@@ -20,40 +23,81 @@ class ArrayStack {
  public:
     ArrayStack() {
         max_size_ = DEFAULT_SIZE;
-        contents = new T[max_size_];
+        contents = std::allocator<T>().allocate(max_size_);
         top_ = -1;
     }
 
     explicit ArrayStack(std::size_t max) {
         // param o parametro max define o tamanho genérico da pilha.
         max_size_ = max;
-        contents = new T[max_size_];
+        contents = std::allocator<T>().allocate(max_size_);
         top_ = -1;
     }
 
+    ArrayStack(const ArrayStack& other) {
+        max_size_ = other.max_size_;
+        contents = std::allocator<T>().allocate(max_size_);
+        for (top_ = -1; top_ < other.top_; top_++) {
+            new (contents + top_ + 1) T(other.contents[top_+1]);
+        }
+    }
+
+    ArrayStack(ArrayStack&& other) noexcept {
+        max_size_ = other.max_size_;
+        contents = other.contents;
+        top_ = other.top_;
+        other.contents = nullptr;
+        other.max_size_ = 0;
+        other.top_ = -1;
+    }  // toma o vetor de other sem copiar os dados
+
+    ArrayStack& operator=(ArrayStack other) {
+        std::swap(contents, other.contents);
+        std::swap(top_, other.top_);
+        std::swap(max_size_, other.max_size_);
+        return *this;
+    }  // cópia ou movimento conforme o argumento
+
     ~ArrayStack() {
-        delete[] contents;
+        clear();
+        std::allocator<T>().deallocate(contents, max_size_);
     }
 
     //! Método push
     /*! O metódo push empilha os dados enquanto a pilha não estiver cheia. */
     void push(const T& data) {
+        emplace(data);
+    }  // empilha
+
+    //! Método push
+    /*! O metódo push move os dados para o topo da pilha. */
+    void push(T&& data) {
+        emplace(std::move(data));
+    }  // empilha sem copiar
+
+    //! Método emplace
+    /*! O metódo emplace constrói um dado no topo da pilha a partir dos
+     *  argumentos. */
+    template<typename... Args>
+    T& emplace(Args&&... args) {
         if (full()) {
             throw(std::out_of_range("A pilha está cheia."));  // excecao
         }
+        new (contents + top_ + 1) T(std::forward<Args>(args)...);
         top_++;
-        contents[top_] = data;
-    }  // empilha
+        return contents[top_];
+    }  // constrói no lugar
 
     //! Método pop
     /*! O método pop desempilha os dados até que a pilha fique vazia. */
     T pop() {
         if (empty()) {
             throw(std::out_of_range("A pilha está vazia."));  // excecao
-            return 0;
         }
+        T back = std::move(contents[top_]);
+        contents[top_].~T();
         top_--;
-        return contents[top_+1];
+        return back;
     }  // desempilha
 
     //! Método top
@@ -69,7 +113,9 @@ class ArrayStack {
     //! Método clear
     /*! O método clear limpa a pilha. */
     void clear() {
-        top_ = -1;
+        for (; top_ >= 0; top_--) {
+            contents[top_].~T();
+        }
     }  // limpa
 
     //! Método size
@@ -1,58 +1,117 @@
 #ifndef STRUCTURES_LINKED_STACK_H
 #define STRUCTURES_LINKED_STACK_H
 
+#include <atomic>  // std::atomic
 #include <cstdint>  // std::size_t
+#include <memory>  // std::allocator_traits
 #include <stdexcept>  // C++ exceptions
+#include <utility>  // std::move, std::forward, std::swap
+
+#include "./Alocador.hpp"
 
 namespace structures {
 
 //! Classe LinkedStack
 /*! A Classe LinkedStack é uma pilha de dados encadea. */
 
-template<typename T>
+template<typename T, typename Alloc = std::allocator<T>>
 class LinkedStack {
  public:
     LinkedStack() = default;
 
-    ~LinkedStack() {
-        Node *current, *previous;
-        current = top_;
-        while (current != nullptr) {
-            previous = current;
-            current = current->next();
-            delete previous;
+    explicit LinkedStack(const Alloc& alloc):
+        alloc_{alloc}
+    {}  // nodos alocados por alloc
+
+    LinkedStack(const LinkedStack& other):
+        alloc_{NodeTraits::select_on_container_copy_construction(other.alloc_)}
+    {
+        Node *last = nullptr;
+        for (const Node *n = other.top_; n != nullptr; n = n->next()) {
+            Node *copy = create(nullptr, n->data());
+            if (last == nullptr) {
+                top_ = copy;
+            } else {
+                last->next(copy);
+            }
+            last = copy;
+            size_++;
         }
+    }  // cópia do topo para a base, na mesma ordem
+
+    LinkedStack(LinkedStack&& other) noexcept:
+        top_{other.top_},
+        size_{other.size_},
+        alloc_{std::move(other.alloc_)}
+    {
+        other.top_ = nullptr;
+        other.size_ = 0;
+    }  // toma os nodos de other
+
+    LinkedStack& operator=(LinkedStack other) {
+        swap(other);
+        return *this;
+    }  // cópia ou movimento conforme o argumento
+
+    ~LinkedStack() {
+        clear();
+    }
+
+    //! Método swap
+    /*! O método swap troca o conteúdo de duas pilhas em O(1). */
+    void swap(LinkedStack& other) noexcept {
+        std::swap(top_, other.top_);
+        std::swap(size_, other.size_);
+        std::swap(alloc_, other.alloc_);
     }
 
     //! Método clear
     /*! O método clear limpa a pilha. */
     void clear() {
-        Node *previous = top_;
-        while (previous != nullptr) {
-            previous = previous->next();
-            pop();
+        if (!release_arena(alloc_)) {
+            Node *current = top_;
+            while (current != nullptr) {
+                Node *previous = current;
+                current = current->next();
+                dispose(previous);
+            }
         }
+        top_ = nullptr;
         size_ = 0;
-    }  // limpa pilha
+    }  // limpa pilha; com arena, todos os nodos de uma vez
 
     //! Método push
     /*! O metódo push empilha os dados na pilha. */
     void push(const T& data) {
-        top_ = new Node(data, top_);
-        size_++;
+        emplace(data);
     }  // empilha
 
+    //! Método push
+    /*! O metódo push move os dados para o topo da pilha. */
+    void push(T&& data) {
+        emplace(std::move(data));
+    }  // empilha sem copiar
+
+    //! Método emplace
+    /*! O metódo emplace constrói um dado no topo da pilha a partir dos
+     *  argumentos. */
+    template<typename... Args>
+    T& emplace(Args&&... args) {
+        top_ = create(top_, std::forward<Args>(args)...);
+        size_++;
+        return top_->data();
+    }  // constrói no lugar
+
     //! Método pop
     /*! O método pop desempilha os dados até que a pilha fique vazia. */
     T pop() {
-        T back;
         if (empty()) {
             throw(std::out_of_range("A pilha está vazia."));
         }
         Node *out = top_;
-        back = out->data();
+        T back = std::move(out->data());
         top_= out->next();
-        delete out;
+        dispose(out);
         size_--;
         return back;
     }  // desempilha
@@ -81,14 +140,11 @@ class LinkedStack {
  private:
     class Node {
      public:
-        explicit Node(const T& data) {
-            data_ = data;
-        }
-
-        Node(const T& data, Node* next) {
-            data_ = data;
-            next_ = next;
-        }
+        template<typename... Args>
+        explicit Node(Node* next, Args&&... args):
+            data_(std::forward<Args>(args)...),
+            next_{next}
+        {}  // dado construído no próprio nodo
 
         T& data() {
             return data_;
@@ -115,8 +171,254 @@ class LinkedStack {
         Node* next_;
     };
 
+    using NodeAlloc =
+        typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAlloc>;
+
+    template<typename... Args>
+    Node* create(Args&&... args) {
+        Node *n = NodeTraits::allocate(alloc_, 1);
+        try {
+            NodeTraits::construct(alloc_, n, std::forward<Args>(args)...);
+        } catch (...) {
+            NodeTraits::deallocate(alloc_, n, 1);
+            throw;
+        }
+        return n;
+    }  // nodo construído na memória do alocador
+
+    void dispose(Node* n) {
+        NodeTraits::destroy(alloc_, n);
+        NodeTraits::deallocate(alloc_, n, 1);
+    }
+
     Node* top_{nullptr};  // nodo-topo
     std::size_t size_{0u};  // tamanho
+    NodeAlloc alloc_;
+};
+
+//! Classe ConcurrentLinkedStack
+/*! A Classe ConcurrentLinkedStack é uma pilha encadeada sem travas para
+ *  várias threads (pilha de Treiber). Os nodos desempilhados são liberados
+ *  com hazard pointers: um nodo lido por outra thread não é apagado nem
+ *  reaproveitado, então o topo nunca volta a um endereço já visto (ABA). */
+
+template<typename T>
+class ConcurrentLinkedStack {
+ public:
+    ConcurrentLinkedStack() = default;
+
+    ConcurrentLinkedStack(const ConcurrentLinkedStack&) = delete;
+    ConcurrentLinkedStack& operator=(const ConcurrentLinkedStack&) = delete;
+
+    ~ConcurrentLinkedStack() {
+        Node *current = top_.load(std::memory_order_relaxed);
+        while (current != nullptr) {
+            Node *previous = current;
+            current = current->next;
+            delete previous;
+        }
+        HazardRecord *record = records.load(std::memory_order_relaxed);
+        while (record != nullptr) {
+            HazardRecord *previous = record;
+            record = record->next;
+            Node *retired = previous->retired;
+            while (retired != nullptr) {
+                Node *out = retired;
+                retired = retired->retired_next;
+                delete out;
+            }
+            delete previous;
+        }
+    }
+
+    //! Método push
+    /*! O metódo push empilha os dados na pilha. */
+    void push(const T& data) {
+        emplace(data);
+    }  // empilha
+
+    //! Método push
+    /*! O metódo push move os dados para o topo da pilha. */
+    void push(T&& data) {
+        emplace(std::move(data));
+    }  // empilha sem copiar
+
+    //! Método emplace
+    /*! O metódo emplace empilha um dado construído a partir dos argumentos;
+     *  o nodo é criado antes de disputar o topo. */
+    template<typename... Args>
+    void emplace(Args&&... args) {
+        Node *n = new Node(std::forward<Args>(args)...);
+        n->next = top_.load(std::memory_order_relaxed);
+        while (!top_.compare_exchange_weak(n->next, n,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed)) {}
+        size_.fetch_add(1, std::memory_order_relaxed);
+    }  // constrói e publica
+
+    //! Método try_pop
+    /*! O método try_pop desempilha um dado para out; retorna false se a
+     *  pilha está vazia. */
+    bool try_pop(T& out) {
+        HazardRecord *record = acquire();
+        Node *n = unlink_top(record);
+        if (n == nullptr) {
+            release(record);
+            return false;
+        }
+        out = take(record, n);
+        return true;
+    }
+
+    //! Método pop
+    /*! O método pop desempilha os dados até que a pilha fique vazia. */
+    T pop() {
+        HazardRecord *record = acquire();
+        Node *n = unlink_top(record);
+        if (n == nullptr) {
+            release(record);
+            throw(std::out_of_range("A pilha está vazia."));
+        }
+        return take(record, n);
+    }  // desempilha
+
+    //! Método empty
+    /*! O método empty verifica se a pilha está vazia. */
+    bool empty() const {
+        return (top_.load(std::memory_order_acquire) == nullptr);
+    }  // pilha vazia
+
+    //! Método size
+    /*! O método size retorna uma estimativa do tamanho da pilha. */
+    std::size_t size() const {
+        long size = size_.load(std::memory_order_relaxed);
+        return (size > 0 ? size : 0);
+    }  // tamanho da pilha
+
+ private:
+    struct Node {
+        template<typename... Args>
+        explicit Node(Args&&... args) : data(std::forward<Args>(args)...) {}
+
+        T data;
+        Node* next{nullptr};  // só muda antes de o nodo ser publicado
+        Node* retired_next{nullptr};  // lista de nodos aguardando liberação
+    };
+
+    struct HazardRecord {
+        std::atomic<Node*> hazard{nullptr};
+        std::atomic<bool> active{true};
+        HazardRecord* next{nullptr};
+        Node* retired{nullptr};  // só acessado por quem detém o registro
+        std::size_t retired_count{0u};
+    };
+
+    static const std::size_t RETIRE_THRESHOLD = 64u;
+
+    Node* unlink_top(HazardRecord* record) {
+        for (;;) {
+            Node *n = protect(record, top_);
+            if (n == nullptr) {
+                return nullptr;
+            }
+            Node *next = n->next;  // n protegido: não foi apagado
+            if (top_.compare_exchange_strong(n, next)) {
+                return n;
+            }
+        }
+    }  // desliga o topo; só quem o desligou acessa o dado
+
+    T take(HazardRecord* record, Node* n) {
+        record->hazard.store(nullptr);
+        try {
+            T back(std::move(n->data));
+            retire(record, n);
+            release(record);
+            size_.fetch_sub(1, std::memory_order_relaxed);
+            return back;
+        } catch (...) {
+            retire(record, n);
+            release(record);
+            size_.fetch_sub(1, std::memory_order_relaxed);
+            throw;
+        }
+    }  // move o dado para fora e entrega o nodo aos hazard pointers
+
+    HazardRecord* acquire() {
+        HazardRecord *record = records.load(std::memory_order_acquire);
+        for (; record != nullptr; record = record->next) {
+            bool idle = false;
+            if (!record->active.load(std::memory_order_relaxed) &&
+                record->active.compare_exchange_strong(idle, true)) {
+                return record;
+            }
+        }
+        record = new HazardRecord();
+        HazardRecord *first = records.load(std::memory_order_relaxed);
+        do {
+            record->next = first;
+        } while (!records.compare_exchange_weak(first, record));
+        return record;
+    }  // obtém um registro de hazard pointers livre (ou cria um)
+
+    void release(HazardRecord* record) {
+        record->hazard.store(nullptr);
+        record->active.store(false, std::memory_order_release);
+    }
+
+    Node* protect(HazardRecord* record, std::atomic<Node*>& source) {
+        Node *n = source.load();
+        for (;;) {
+            record->hazard.store(n);
+            Node *check = source.load();
+            if (check == n) {
+                return n;
+            }
+            n = check;
+        }
+    }  // publica o nodo lido e confirma que ainda está no topo
+
+    void retire(HazardRecord* record, Node* n) {
+        n->retired_next = record->retired;
+        record->retired = n;
+        if (++record->retired_count >= RETIRE_THRESHOLD) {
+            scan(record);
+        }
+    }  // chamado com o registro ainda ativo
+
+    void scan(HazardRecord* owner) {
+        Node *keep = nullptr;
+        std::size_t kept = 0u;
+        Node *retired = owner->retired;
+        while (retired != nullptr) {
+            Node *n = retired;
+            retired = retired->retired_next;
+            if (hazardous(n)) {
+                n->retired_next = keep;
+                keep = n;
+                kept++;
+            } else {
+                delete n;
+            }
+        }
+        owner->retired = keep;
+        owner->retired_count = kept;
+    }  // libera os nodos que nenhuma thread está lendo
+
+    bool hazardous(Node* n) const {
+        HazardRecord *record = records.load(std::memory_order_acquire);
+        for (; record != nullptr; record = record->next) {
+            if (record->hazard.load() == n) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    alignas(64) std::atomic<Node*> top_{nullptr};  // nodo-topo
+    alignas(64) std::atomic<long> size_{0};  // tamanho
+    std::atomic<HazardRecord*> records{nullptr};
 };
 
 }  // namespace structures
@@ -0,0 +1,46 @@
+//! Medida da inserção ordenada na AVLTree
+/*! Insere n chaves em ordem crescente, o pior caso sem balanço, e mede o
+ *  tempo e a altura final; a altura deve ficar perto de log2(n).
+ *  Compilar da raiz do repositório, onde array_list.h é o Lista.hpp:
+ *      ln -s Lista.hpp array_list.h
+ *      g++ -std=c++11 -O2 -I. bench/arvore_avl_insercao.cpp
+ *  Uso: ./a.out [n], com n = 10000000 por padrão. */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "ArvoreAVL.hpp"
+
+namespace {
+
+int height(const structures::ArrayList<int>& pre, std::size_t& i,
+           long lower, long upper) {
+    if (i == pre.size() || pre[i] < lower || pre[i] > upper) {
+        return -1;
+    }
+    int key = pre[i++];
+    int left = height(pre, i, lower, key - 1L);
+    int right = height(pre, i, key + 1L, upper);
+    return (left > right ? left : right) + 1;
+}  // reconstrói a forma a partir da pré-ordem; as chaves são distintas
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int n = (argc > 1 ? std::atoi(argv[1]) : 10000000);
+    structures::AVLTree<int> tree;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        tree.insert(i);
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    std::size_t i = 0;
+    int h = height(tree.pre_order(), i, 0L, n - 1L);
+    std::printf("%d inserções ordenadas: %.2f s, altura %d\n",
+                n, elapsed.count(), h);
+    return 0;
+}
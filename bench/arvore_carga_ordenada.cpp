@@ -0,0 +1,56 @@
+//! Medida da carga ordenada das árvores
+/*! Monta uma AVLTree com n chaves já ordenadas de três formas: inserindo
+ *  uma a uma, com from_sorted e com from_sorted sobre um PoolAllocator,
+ *  que tira todos os nodos de um só bloco.
+ *  Compilar da raiz do repositório, onde array_list.h é o Lista.hpp:
+ *      ln -s Lista.hpp array_list.h
+ *      g++ -std=c++11 -O2 -I. bench/arvore_carga_ordenada.cpp
+ *  Uso: ./a.out [n], com n = 5000000 por padrão. */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "Alocador.hpp"
+#include "ArvoreAVL.hpp"
+
+namespace {
+
+template<typename Build>
+void measure(const char* name, Build build) {
+    auto start = std::chrono::steady_clock::now();
+    std::size_t size = build();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    std::printf("%-22s %.2f s (%zu chaves)\n", name, elapsed.count(), size);
+}  // inclui a destruição da árvore
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int n = (argc > 1 ? std::atoi(argv[1]) : 5000000);
+    std::vector<int> keys(n);
+    for (int i = 0; i < n; i++) {
+        keys[i] = 2 * i;
+    }
+
+    measure("insert", [&] {
+        structures::AVLTree<int> tree;
+        for (int key : keys) {
+            tree.insert(key);
+        }
+        return tree.size();
+    });
+    measure("from_sorted", [&] {
+        auto tree = structures::AVLTree<int>::from_sorted(keys.begin(),
+                                                          keys.end());
+        return tree.size();
+    });
+    measure("from_sorted com pool", [&] {
+        using Tree = structures::AVLTree<int, structures::PoolAllocator<int>>;
+        auto tree = Tree::from_sorted(keys.begin(), keys.end());
+        return tree.size();
+    });
+    return 0;
+}
@@ -0,0 +1,61 @@
+//! Medida da busca na FrozenTree
+/*! Para árvores de 1e3 a 1e7 chaves, faz as mesmas buscas aleatórias com
+ *  AVLTree::contains e com contains da cópia congelada (layout de
+ *  Eytzinger), imprimindo o tempo médio de cada busca.
+ *  Compilar da raiz do repositório, onde array_list.h é o Lista.hpp:
+ *      ln -s Lista.hpp array_list.h
+ *      g++ -std=c++11 -O2 -I. bench/arvore_congelada_busca.cpp
+ *  Uso: ./a.out [buscas], com 4000000 por padrão. */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "ArvoreAVL.hpp"
+
+namespace {
+
+template<typename Tree>
+double nanoseconds_per_lookup(const Tree& tree, const std::vector<int>& keys,
+                              long& hits) {
+    hits = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int key : keys) {
+        hits += tree.contains(key);
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count() / keys.size() * 1e9;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t lookups = (argc > 1 ? std::atol(argv[1]) : 4000000L);
+    const std::size_t sizes[] = {1000u, 30000u, 1000000u, 10000000u};
+    bool ok = true;
+    for (std::size_t n : sizes) {
+        std::vector<int> keys(n);
+        for (std::size_t i = 0; i < n; i++) {
+            keys[i] = static_cast<int>(2 * i);
+        }  // só as chaves pares existem: metade das buscas falha
+        auto tree = structures::AVLTree<int>::from_sorted(keys.begin(),
+                                                          keys.end());
+        auto frozen = tree.freeze();
+
+        std::mt19937 random(1);
+        std::vector<int> queries(lookups);
+        for (int& key : queries) {
+            key = static_cast<int>(random() % (2 * n));
+        }
+        long hits, frozen_hits;
+        double avl = nanoseconds_per_lookup(tree, queries, hits);
+        double flat = nanoseconds_per_lookup(frozen, queries, frozen_hits);
+        ok = ok && hits == frozen_hits;
+        std::printf("%8zu chaves: AVLTree %6.1f ns, FrozenTree %6.1f ns, "
+                    "x%.1f\n", n, avl, flat, avl / flat);
+    }
+    return (ok ? 0 : 1);
+}
@@ -0,0 +1,43 @@
+//! Medida da vazão da ArrayQueue circular
+/*! Alterna enqueue e dequeue numa fila meio cheia, que dá a volta no
+ *  buffer várias vezes, com capacidade potência de dois (máscara) e sem
+ *  ela (módulo).
+ *  Compilar da raiz do repositório:
+ *      g++ -std=c++11 -O2 -I. bench/fila_circular.cpp
+ *  Uso: ./a.out [operações], com 100000000 por padrão. */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "Fila.hpp"
+
+namespace {
+
+void measure(std::size_t max, long ops) {
+    structures::ArrayQueue<long> queue(max);
+    for (std::size_t i = 0; i < max / 2; i++) {
+        queue.enqueue(static_cast<long>(i));
+    }
+
+    long sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < ops; i++) {
+        queue.enqueue(i);
+        sum += queue.dequeue();
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    std::printf("capacidade %zu: %.0f Mops/s (soma %ld)\n", max,
+                2.0 * ops / elapsed.count() / 1e6, sum);
+}  // cada volta conta duas operações: um enqueue e um dequeue
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    long ops = (argc > 1 ? std::atol(argv[1]) : 100000000L);
+    measure(1024u, ops);
+    measure(1000u, ops);
+    return 0;
+}
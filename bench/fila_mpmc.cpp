@@ -0,0 +1,75 @@
+//! Medida da MPMCArrayQueue com várias threads
+/*! Para 1 a 4 produtores e outros tantos consumidores, cada produtor
+ *  enfileira a sua faixa de inteiros e cada consumidor anota o que
+ *  recebeu; ao fim, cada inteiro deve ter chegado exatamente uma vez.
+ *  Compilar da raiz do repositório:
+ *      g++ -std=c++11 -O2 -pthread -I. bench/fila_mpmc.cpp
+ *  Uso: ./a.out [n], com n = 1000000 inteiros por produtor por padrão. */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "Fila.hpp"
+
+namespace {
+
+bool measure(int threads, long n) {
+    structures::MPMCArrayQueue<long> queue(1024u);
+    long total = threads * n;
+    std::vector<std::vector<long>> received(threads);
+    std::vector<std::thread> workers;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&queue, t, n] {
+            for (long i = t * n; i < (t + 1) * n; i++) {
+                while (!queue.try_enqueue(i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        workers.emplace_back([&queue, &received, t, n] {
+            long data;
+            for (long i = 0; i < n; i++) {
+                while (!queue.try_dequeue(data)) {
+                    std::this_thread::yield();
+                }
+                received[t].push_back(data);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    std::vector<int> seen(total, 0);
+    for (auto& part : received) {
+        for (long data : part) {
+            seen[data]++;
+        }
+    }
+    long wrong = 0;
+    for (int count : seen) {
+        wrong += (count != 1);
+    }
+    std::printf("%d x %d threads: %.2f s, %.1f Mops/s, %ld perdidos ou "
+                "repetidos\n", threads, threads, elapsed.count(),
+                total / elapsed.count() / 1e6, wrong);
+    return wrong == 0;
+}  // cada consumidor retira n dados, então o total fecha
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    long n = (argc > 1 ? std::atol(argv[1]) : 1000000L);
+    bool ok = true;
+    for (int threads = 1; threads <= 4; threads++) {
+        ok = measure(threads, n) && ok;
+    }
+    return (ok ? 0 : 1);
+}
@@ -0,0 +1,42 @@
+//! Medida da SPSCArrayQueue entre duas threads
+/*! Uma thread produz n inteiros em ordem e outra os consome, conferindo
+ *  que todos chegam na ordem em que foram produzidos.
+ *  Compilar da raiz do repositório:
+ *      g++ -std=c++11 -O2 -pthread -I. bench/fila_spsc.cpp
+ *  Uso: ./a.out [n], com n = 5000000 por padrão. */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#include "Fila.hpp"
+
+int main(int argc, char* argv[]) {
+    long n = (argc > 1 ? std::atol(argv[1]) : 5000000L);
+    structures::SPSCArrayQueue<long> queue(1024u);
+    long out_of_order = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    std::thread consumer([&] {
+        long data;
+        for (long expected = 0; expected < n; expected++) {
+            while (!queue.try_dequeue(data)) {
+                std::this_thread::yield();
+            }
+            out_of_order += (data != expected);
+        }
+    });
+    for (long i = 0; i < n; i++) {
+        while (!queue.try_enqueue(i)) {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    std::printf("%ld repasses: %.2f s, %.1f Mops/s, %ld fora de ordem\n",
+                n, elapsed.count(), n / elapsed.count() / 1e6, out_of_order);
+    return (out_of_order == 0 ? 0 : 1);
+}
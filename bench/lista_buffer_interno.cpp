@@ -0,0 +1,57 @@
+//! Medida das alocações do ArrayList com buffer interno
+/*! Cria e enche muitas listas curtas, com menos de 16 dados, como
+ *  ArrayList<int, 16> e como ArrayList<int>, contando as alocações pelo
+ *  operator new global e medindo o tempo de cada caso.
+ *  Compilar da raiz do repositório:
+ *      g++ -std=c++11 -O2 -I. bench/lista_buffer_interno.cpp
+ *  Uso: ./a.out [listas], com 100000 por padrão. */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include "Lista.hpp"
+
+namespace {
+
+std::size_t allocations = 0;
+
+template<typename List>
+void measure(const char* name, long lists) {
+    std::size_t before = allocations;
+    long sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < lists; i++) {
+        List list(16u, 2.0);  // cabe no buffer de ArrayList<int, 16>
+        for (long j = 0; j < i % 16; j++) {
+            list.push_back(static_cast<int>(j));
+        }
+        sum += list.size();
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    std::printf("%-22s %zu alocações, %.3f s (soma %ld)\n", name,
+                allocations - before, elapsed.count(), sum);
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+    allocations++;
+    if (void* p = std::malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+int main(int argc, char* argv[]) {
+    long lists = (argc > 1 ? std::atol(argv[1]) : 100000L);
+    measure<structures::ArrayList<int, 16>>("ArrayList<int, 16>", lists);
+    measure<structures::ArrayList<int>>("ArrayList<int>", lists);
+    return 0;
+}
@@ -0,0 +1,72 @@
+//! Medida da busca vetorial do ArrayList
+/*! Procura um valor ausente numa lista de n dados, o que percorre a lista
+ *  toda, com ArrayList::find (busca vetorial) e com um laço escalar
+ *  sobre os mesmos dados, para int32_t, int64_t, float e double.
+ *  Compilar da raiz do repositório:
+ *      g++ -std=c++11 -O2 -I. bench/lista_busca_vetorial.cpp
+ *  Uso: ./a.out [n], com n = 4194304 por padrão. */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "Lista.hpp"
+
+namespace {
+
+template<typename T>
+std::size_t scalar_find(const structures::ArrayList<T>& list, T data) {
+    for (std::size_t i = 0; i < list.size(); i++) {
+        if (list[i] == data) {
+            return i;
+        }
+    }
+    return list.size();
+}
+
+template<typename Find>
+double gigabytes_per_second(std::size_t n, std::size_t bytes, Find find) {
+    const int rounds = 50;
+    std::size_t found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        found += find();
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (found != rounds * n) {
+        std::printf("a busca achou um valor ausente\n");
+        std::exit(1);
+    }
+    return rounds * static_cast<double>(bytes) / elapsed.count() / 1e9;
+}  // o valor procurado não está na lista: cada busca retorna size()
+
+template<typename T>
+void measure(const char* name, std::size_t n) {
+    structures::ArrayList<T> list(n);
+    for (std::size_t i = 0; i < n; i++) {
+        list.push_back(static_cast<T>(i % 1000));
+    }
+    const T missing = static_cast<T>(-1);
+    std::size_t bytes = n * sizeof(T);
+    double simd = gigabytes_per_second(n, bytes, [&] {
+        return list.find(missing);
+    });
+    double scalar = gigabytes_per_second(n, bytes, [&] {
+        return scalar_find(list, missing);
+    });
+    std::printf("%-8s vetorial %6.2f GB/s, escalar %6.2f GB/s, x%.1f\n",
+                name, simd, scalar, simd / scalar);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t n = (argc > 1 ? std::atol(argv[1]) : 4194304L);
+    measure<std::int32_t>("int32_t", n);
+    measure<std::int64_t>("int64_t", n);
+    measure<float>("float", n);
+    measure<double>("double", n);
+    return 0;
+}
@@ -0,0 +1,44 @@
+//! Medida do push_back da LinkedList
+/*! Monta uma lista com n push_back e outra com n insert(dado, size()),
+ *  os dois caminhos que usam o ponteiro para o último nodo; com ele,
+ *  o tempo cresce linearmente com n.
+ *  Compilar da raiz do repositório:
+ *      g++ -std=c++11 -O2 -I. bench/lista_encadeada_append.cpp
+ *  Uso: ./a.out [n], com n = 10000000 por padrão. */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "ListaEncadeada.hpp"
+
+namespace {
+
+template<typename Append>
+bool measure(const char* name, long n, Append append) {
+    structures::LinkedList<long> list;
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < n; i++) {
+        append(list, i);
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    std::printf("%ld x %s: %.2f s\n", n, name, elapsed.count());
+    return list.size() == static_cast<std::size_t>(n) &&
+           (n == 0 || list.pop_back() == n - 1);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    long n = (argc > 1 ? std::atol(argv[1]) : 10000000L);
+    bool ok = measure("push_back", n,
+        [](structures::LinkedList<long>& list, long i) {
+            list.push_back(i);
+        });
+    ok = measure("insert(dado, size())", n,
+        [](structures::LinkedList<long>& list, long i) {
+            list.insert(i, list.size());
+        }) && ok;
+    return (ok ? 0 : 1);
+}
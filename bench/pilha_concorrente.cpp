@@ -0,0 +1,65 @@
+//! Medida da ConcurrentLinkedStack contra uma LinkedStack com mutex
+/*! Com 1, 2 e 4 threads, cada thread faz n pares push/pop na mesma
+ *  pilha; compara a pilha lock-free com a LinkedStack guardada por um
+ *  std::mutex e confere que as duas terminam vazias.
+ *  Compilar da raiz do repositório:
+ *      g++ -std=c++11 -O2 -pthread -I. bench/pilha_concorrente.cpp
+ *  Uso: ./a.out [n], com n = 1000000 pares por thread por padrão. */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "PilhaEncadeada.hpp"
+
+namespace {
+
+template<typename Work>
+double run(int threads, Work work) {
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back(work);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    long n = (argc > 1 ? std::atol(argv[1]) : 1000000L);
+    bool ok = true;
+    for (int threads = 1; threads <= 4; threads *= 2) {
+        structures::ConcurrentLinkedStack<long> lock_free;
+        double t1 = run(threads, [&lock_free, n] {
+            long data;
+            for (long i = 0; i < n; i++) {
+                lock_free.push(i);
+                lock_free.try_pop(data);
+            }
+        });
+
+        structures::LinkedStack<long> locked;
+        std::mutex mutex;
+        double t2 = run(threads, [&locked, &mutex, n] {
+            for (long i = 0; i < n; i++) {
+                std::lock_guard<std::mutex> lock(mutex);
+                locked.push(i);
+                locked.pop();
+            }
+        });
+
+        ok = ok && lock_free.empty() && locked.empty();
+        std::printf("%d threads: lock-free %.2f s, mutex %.2f s\n",
+                    threads, t1, t2);
+    }
+    return (ok ? 0 : 1);
+}
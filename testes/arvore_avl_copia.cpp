@@ -0,0 +1,66 @@
+//! Teste da cópia da AVLTree
+/*! Copia uma árvore e altera a cópia, verificando a condição de balanço.
+ *  Com chaves distintas, a pré-ordem determina a forma da árvore.
+ *  Compilar da raiz do repositório, onde array_list.h é o Lista.hpp:
+ *      ln -s Lista.hpp array_list.h
+ *      g++ -std=c++11 -I. testes/arvore_avl_copia.cpp */
+
+#include <cassert>
+#include <cstdio>
+#include <random>
+#include <set>
+
+#include "ArvoreAVL.hpp"
+
+namespace {
+
+int check(const structures::ArrayList<int>& pre, std::size_t& i,
+          long lower, long upper) {
+    if (i == pre.size() || pre[i] < lower || pre[i] > upper) {
+        return -1;
+    }
+    int key = pre[i++];
+    int left = check(pre, i, lower, key - 1L);
+    int right = check(pre, i, key + 1L, upper);
+    assert(left - right <= 1 && right - left <= 1);
+    return (left > right ? left : right) + 1;
+}  // reconstrói a forma a partir da pré-ordem e retorna a altura
+
+void check_balance(const structures::AVLTree<int>& tree) {
+    structures::ArrayList<int> pre = tree.pre_order();
+    std::size_t i = 0;
+    check(pre, i, -2147483648L, 2147483647L);
+    assert(i == pre.size());
+}
+
+}  // namespace
+
+int main() {
+    for (unsigned seed = 0; seed < 20; seed++) {
+        std::mt19937 random(seed);
+        structures::AVLTree<int> original;
+        std::set<int> keys;
+        for (int i = 0; i < 2000; i++) {
+            int key = random() % 5000;
+            if (keys.insert(key).second) {
+                original.insert(key);
+            }
+        }
+        structures::AVLTree<int> copy(original);
+        check_balance(copy);
+        for (int i = 0; i < 4000; i++) {
+            int key = random() % 5000;
+            if (random() % 2 == 0) {
+                if (keys.insert(key).second) {
+                    copy.insert(key);
+                }
+            } else if (keys.erase(key) > 0) {
+                copy.remove(key);
+            }
+            check_balance(copy);
+        }
+        assert(copy.size() == keys.size());
+        check_balance(original);
+    }
+    std::puts("ok");
+}
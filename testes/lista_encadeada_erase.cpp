@@ -0,0 +1,95 @@
+//! Teste do erase_at das listas encadeadas
+/*! Remove pelo cursor depois de inserir logo antes dele, quando o nodo
+ *  anterior guardado no cursor já não é o anterior de fato, e percorre o
+ *  restante até end() para conferir que o cursor devolvido não dá a volta
+ *  no anel das listas circulares.
+ *  Compilar da raiz do repositório:
+ *      g++ -std=c++11 -I. testes/lista_encadeada_erase.cpp */
+
+#include <cassert>
+#include <cstdio>
+#include <iterator>
+#include <vector>
+
+#include "ListaCircular.hpp"
+#include "ListaCircularDupla.hpp"
+#include "ListaEncadeada.hpp"
+
+namespace {
+
+template<typename List>
+std::vector<int> contents(const List& list) {
+    return std::vector<int>(list.begin(), list.end());
+}
+
+template<typename List>
+std::vector<int> rest(const List& list, typename List::const_iterator it) {
+    return std::vector<int>(it, list.end());
+}
+
+template<typename List>
+void erase_after_insert_before() {
+    List list;
+    for (int i = 1; i <= 4; i++) {
+        list.push_back(i);
+    }
+    typename List::iterator it = list.begin();
+    typename List::iterator previous = it++;  // previous -> 1, it -> 2
+    list.insert_after(previous, 10);  // 1 10 2 3 4
+    it = list.erase_at(it);
+    assert((rest(list, it) == std::vector<int>{3, 4}));
+    assert((contents(list) == std::vector<int>{1, 10, 3, 4}));
+    assert(list.size() == 4u);
+}
+
+template<typename List>
+void erase_after_push_front() {
+    List list;
+    for (int i = 1; i <= 3; i++) {
+        list.push_back(i);
+    }
+    typename List::iterator it = list.begin();
+    ++it;  // it -> 2
+    list.push_front(0);  // as posições depois do cursor mudam
+    it = list.erase_at(it);
+    assert((rest(list, it) == std::vector<int>{3}));
+    assert((contents(list) == std::vector<int>{0, 1, 3}));
+
+    it = list.begin();
+    list.push_front(-1);  // o cursor não tem mais o anterior certo
+    it = list.erase_at(it);
+    assert((rest(list, it) == std::vector<int>{1, 3}));
+    assert((contents(list) == std::vector<int>{-1, 1, 3}));
+}
+
+template<typename List>
+void erase_last_and_push_back() {
+    List list;
+    list.push_back(1);
+    list.push_back(2);
+    typename List::iterator it = list.begin();
+    ++it;  // it -> 2, o último
+    it = list.erase_at(it);
+    assert(it == list.end());
+    list.push_back(3);
+    it = list.begin();
+    assert((rest(list, ++it) == std::vector<int>{3}));
+    it = list.erase_at(list.begin());
+    it = list.erase_at(it);
+    assert(it == list.end() && list.empty());
+}
+
+}  // namespace
+
+int main() {
+    erase_after_insert_before<structures::LinkedList<int>>();
+    erase_after_push_front<structures::LinkedList<int>>();
+    erase_last_and_push_back<structures::LinkedList<int>>();
+    erase_after_insert_before<structures::CircularList<int>>();
+    erase_after_push_front<structures::CircularList<int>>();
+    erase_last_and_push_back<structures::CircularList<int>>();
+    erase_after_insert_before<structures::DoublyCircularList<int>>();
+    erase_after_push_front<structures::DoublyCircularList<int>>();
+    erase_last_and_push_back<structures::DoublyCircularList<int>>();
+    std::puts("ok");
+}
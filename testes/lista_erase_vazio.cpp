@@ -0,0 +1,27 @@
+//! Teste do erase com intervalo vazio no ArrayList
+/*! Um intervalo vazio não pode alterar a lista: antes, erase(i, i) movia
+ *  cada dado de [i, size) sobre si mesmo e esvaziava as strings.
+ *  Compilar da raiz do repositório:
+ *      g++ -std=c++11 -I. testes/lista_erase_vazio.cpp */
+
+#include <cassert>
+#include <cstdio>
+#include <string>
+
+#include "Lista.hpp"
+
+int main() {
+    const std::string alpha(64, 'a');  // longa demais para o buffer curto
+    structures::ArrayList<std::string> list(4u);
+    list.push_back(alpha);
+    list.push_back("b");
+    list.push_back("c");
+    for (std::size_t i = 0; i <= list.size(); i++) {
+        assert(list.erase(i, i) == 0u);
+        assert(list.size() == 3u);
+        assert(list[0] == alpha && list[1] == "b" && list[2] == "c");
+    }
+    assert(list.erase(0, 2) == 2u);
+    assert(list.size() == 1u && list[0] == "c");
+    std::puts("ok");
+}